@@ -0,0 +1,108 @@
+/**
+ * @file BlockTuner.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Autotuner of the block size and unroll factor of BatchMandelCalculator, stores the winner into the profile file
+ * @date 17.10.2026
+ *
+ * Build (from Project 1):
+ *   g++ -std=c++17 -O3 -march=native -fopenmp -Icalculators benchmark/BlockTuner.cc calculators/[A-Z]*.cc -o block_tuner
+ *
+ * Usage:
+ *   block_tuner [--size 512] [--limit 1000] [--repeat 5] [--dry-run]
+ *
+ * The profile file is given by MANDEL_PROFILE environment variable, or ~/.mandel_profiles (see BlockProfile.h).
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "BlockProfile.h"
+#include "BatchMandelCalculator.h"
+
+
+int main(int argc, char *argv[])
+{
+	unsigned size = 512;
+	unsigned limit = 1000;
+	int repeat = 5;
+	bool dryRun = false;
+
+	try {
+		for (int a = 1; a < argc; ++a){
+			const std::string arg = argv[a];
+			const bool hasValue = a + 1 < argc;
+
+			if (arg == "--dry-run")                  dryRun = true;
+			else if (arg == "--size" && hasValue)    size = std::stoul(argv[++a]);
+			else if (arg == "--limit" && hasValue)   limit = std::stoul(argv[++a]);
+			else if (arg == "--repeat" && hasValue)  repeat = std::max(1, std::stoi(argv[++a]));
+			else throw std::invalid_argument("unknown or incomplete option '" + arg + "'");
+		}
+	} catch (const std::exception &e) {
+		std::cerr << "block_tuner: " << e.what() << std::endl;
+		return 1;
+	}
+
+	// Cache hierarchy decides which block sizes are worth trying
+	long l1Size = 32 * 1024;
+	std::cout << "CPU: " << BlockProfile::cpuModel() << std::endl;
+	for (const CacheLevel &cache : BlockProfile::caches()){
+		std::cout << "L" << cache.level << " " << cache.type << ": " << cache.size / 1024 << " KB, line " << cache.lineSize << " B" << std::endl;
+		if (cache.level == 1 && cache.type == "Data")
+			l1Size = cache.size;
+	}
+
+	// Block of data and both buffers (double precision kernel is the worst case) has to fit into half of L1
+	const long bytesPerElement = sizeof(int) + 2 * sizeof(double);
+
+	BlockProfile best;
+	double bestTime = -1.0;
+	BatchMandelCalculator calc(size, limit);
+
+	for (int blockSize : BlockProfile::blockSizes()){
+		if (blockSize * bytesPerElement > l1Size / 2){
+			std::cout << "block " << blockSize << ": skipped (does not fit into L1)" << std::endl;
+			continue;
+		}
+
+		for (int unroll : BlockProfile::unrolls()){
+			BlockProfile profile;
+			profile.blockSize = blockSize;
+			profile.unroll = unroll;
+			calc.setBlockProfile(profile);
+
+			// Warmup, then median of the runs
+			calc.calculateMandelbrot();
+			std::vector<double> times;
+			for (int r = 0; r < repeat; ++r){
+				auto start = std::chrono::steady_clock::now();
+				calc.calculateMandelbrot();
+				auto end = std::chrono::steady_clock::now();
+				times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+			}
+			std::sort(times.begin(), times.end());
+			const double median = times[times.size() / 2];
+
+			std::cout << "block " << blockSize << ", unroll " << unroll << ": " << median << " ms" << std::endl;
+			if (bestTime < 0.0 || median < bestTime){
+				bestTime = median;
+				best = profile;
+			}
+		}
+	}
+
+	std::cout << "best: block " << best.blockSize << ", unroll " << best.unroll << " (" << bestTime << " ms)" << std::endl;
+	if (dryRun)
+		return 0;
+
+	if (!BlockProfile::store(best)){
+		std::cerr << "block_tuner: can not write profile '" << BlockProfile::path() << "'" << std::endl;
+		return 1;
+	}
+	std::cout << "stored to " << BlockProfile::path() << std::endl;
+	return 0;
+}
@@ -0,0 +1,408 @@
+/**
+ * @file MandelBenchmark.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Benchmark of the Mandelbrot calculators (sweep of calculator, size and limit, hardware counters, baseline comparison)
+ * @date 17.10.2026
+ *
+ * Build (from Project 1):
+ *   g++ -std=c++17 -O3 -march=native -fopenmp -Icalculators benchmark/MandelBenchmark.cc calculators/[A-Z]*.cc -o mandel_benchmark
+ *
+ * Usage:
+ *   mandel_benchmark [--calc ref,line,...] [--size 256,512] [--limit 100,1000] [--warmup 1] [--repeat 5]
+ *                    [--shortcuts] [--save baseline.csv] [--baseline baseline.csv] [--tolerance 0.1]
+ *                    [--pin none|compact|scatter] [--instrument prefix]
+ *
+ * Output is CSV (';' separated): columns of info(batchMode) followed by the median wall time, GFLOPS, cycles per pixel,
+ * instructions per cycle, cache misses and the image rate per NUMA node ("node:GB/s" separated by '|', "-" if the page
+ * placement can not be queried). The image rate is the bytes of the image stored on the node divided by the median time,
+ * i.e. how fast the calculator produces its output there (and how the output is split between the nodes). It is not a
+ * measured memory bandwidth, the calculators are compute bound and write every byte of the image once.
+ *
+ * Timings are absolute, so a baseline applies only to the machine it was recorded on. --save appends the runs to the
+ * file as a section "# machine;<cpu model>;<threads>" (the CPU model as in BlockProfile, threads of the OpenMP pool),
+ * one file can hold the baselines of several machines. With --baseline, only the section of this machine is used (the
+ * last one if it was saved more times), the benchmark fails if there is none. Runs slower than the baseline by more
+ * than the tolerance are reported as regressions and the exit code is 2. Runs are matched by the calculator name
+ * without its variant (e.g. the ISA selected at runtime), size and limit. baseline.csv next to this file is an example
+ * recorded on one machine, record your own with --save.
+ *
+ * With --shortcuts, the calculators that do not support the interior shortcuts are skipped (reported on stderr). The
+ * compact calculator is timed without widening its image to int (calculateCompact()), its image rate is that of the
+ * compact image.
+ *
+ * With -DMANDEL_INSTRUMENT, --instrument writes the statistics of the Line and Batch kernels of every run to
+ * prefix_<calculator>_<size>_<limit>_{rows,blocks,lanes}.csv (see MandelInstrumentation).
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include <omp.h>
+
+#include "PerfCounters.h"
+#include "NumaTopology.h"
+#include "BlockProfile.h"
+#include "MandelImage.h"
+
+#include "RefMandelCalculator.h"
+#include "LineMandelCalculator.h"
+#include "BatchMandelCalculator.h"
+#include "SimdMandelCalculator.h"
+#include "TiledMandelCalculator.h"
+#include "MarianiSilverMandelCalculator.h"
+#include "PerturbationMandelCalculator.h"
+#include "RefillMandelCalculator.h"
+#include "CompactMandelCalculator.h"
+
+// Floating point operations of one iteration (3 mul, 1 add for |z|^2, 4 for the new z)
+static const double FLOPS_PER_ITERATION = 8.0;
+
+
+struct Options
+{
+	std::vector<std::string> calculators = {"ref", "line", "batch", "simd", "tiled", "tiled-numa", "mariani", "perturbation", "refill", "compact"};
+	std::vector<unsigned> sizes = {256, 512};
+	std::vector<unsigned> limits = {100, 1000};
+	int warmup = 1;
+	int repeat = 5;
+	bool shortcuts = false;
+	std::string saveFile;
+	std::string baselineFile;
+	double tolerance = 0.1;
+	ThreadPinning pinning = ThreadPinning::NONE;
+	std::string instrumentPrefix;
+};
+
+struct Result
+{
+	std::string info;     // info(batchMode) columns
+	std::string key;      // name without variant;base size;limit (identifies the run in the baseline)
+	double timeMs;        // median wall time
+	double gflops;
+	double cyclesPerPixel; // -1 = counters not available
+	double ipc;            // instructions per cycle, -1 = counters not available
+	long long cacheMisses;
+	std::string nodeImageRate; // GB/s of the image stored on each node (bytes / median time)
+};
+
+
+/**
+ * @brief Timed part of a run
+ */
+template <typename Calc>
+static void calculate(Calc &calc)
+{
+	calc.calculateMandelbrot();
+}
+
+static void calculate(CompactMandelCalculator &calc)
+{
+	// The widening to int is only an adapter for the common interface, it is not part of the compact calculation
+	calc.calculateCompact();
+}
+
+struct ImageStats
+{
+	long long iterations;      // iterations of the full image (mirrored rows included)
+	std::vector<long> perNode; // bytes of the stored image on each node
+};
+
+template <typename Out>
+static ImageStats viewStats(const MandelImageView<Out> &view)
+{
+	ImageStats stats = {0, NumaTopology::bytesPerNode(view.data, (size_t)view.storedRows * view.width * sizeof(Out))};
+	for (int i = 0; i < view.height; ++i){
+		const Out *row = view.row(i);
+		for (int j = 0; j < view.width; ++j)
+			stats.iterations += row[j];
+	}
+	return stats;
+}
+
+/**
+ * @brief Recomputes the image (untimed) and returns its iterations and placement
+ */
+template <typename Calc>
+static ImageStats imageStats(Calc &calc)
+{
+	return viewStats(MandelImageView<int>{calc.calculateMandelbrot(), calc.width, calc.height, calc.height});
+}
+
+static ImageStats imageStats(CompactMandelCalculator &calc)
+{
+	calc.calculateCompact();
+	return (calc.format() == CompactMandelCalculator::Format::U8) ? viewStats(calc.view<uint8_t>())
+	                                                              : viewStats(calc.view<uint16_t>());
+}
+
+/**
+ * @brief Runs the calculator warmup + repeat times and measures the repeated runs
+ */
+template <typename Calc>
+static Result benchmark(Calc &calc, const Options &opts, PerfCounters &counters)
+{
+	// Calculators without the shortcuts are skipped, their rows would be the same as without --shortcuts
+	if (opts.shortcuts && !calc.setInteriorShortcuts(true, true))
+		throw std::invalid_argument("interior shortcuts are not supported");
+
+	for (int r = 0; r < opts.warmup; ++r)
+		calculate(calc);
+
+	std::vector<double> times;
+	long long cycles = 0;
+	long long instructions = 0;
+	long long misses = 0;
+
+	for (int r = 0; r < opts.repeat; ++r){
+		counters.start();
+		auto start = std::chrono::steady_clock::now();
+		calculate(calc);
+		auto end = std::chrono::steady_clock::now();
+		counters.stop();
+
+		times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+		cycles += counters.value(PerfCounters::CYCLES);
+		instructions += counters.value(PerfCounters::INSTRUCTIONS);
+		misses += counters.value(PerfCounters::CACHE_MISSES);
+	}
+
+	std::sort(times.begin(), times.end());
+	const double median = times[times.size() / 2];
+	const long long pixels = (long long)calc.width * calc.height;
+
+	// Iterations of the full image are the work of the reference calculator. The image is rewritten by every run,
+	// its bytes on each node divided by the time give the image rate of the node (not its memory bandwidth).
+	const ImageStats stats = imageStats(calc);
+	const std::vector<long> &perNode = stats.perNode;
+	std::ostringstream imageRate;
+	for (size_t node = 0; node < perNode.size(); ++node){
+		if (perNode[node] == 0) continue;
+		if (imageRate.tellp() > 0) imageRate << "|";
+		imageRate << node << ":" << perNode[node] / (median * 1e6);
+	}
+
+	std::ostringstream info;
+	calc.info(info, true);
+
+	Result result;
+	result.info = info.str();
+	result.timeMs = median;
+	result.gflops = stats.iterations * FLOPS_PER_ITERATION / (median * 1e6);
+	result.cyclesPerPixel = counters.available() ? (double)cycles / opts.repeat / pixels : -1.0;
+	result.ipc = (counters.available() && cycles > 0) ? (double)instructions / cycles : -1.0;
+	result.cacheMisses = counters.available() ? misses / opts.repeat : -1;
+	result.nodeImageRate = perNode.empty() ? "-" : imageRate.str();
+	return result;
+}
+
+#ifdef MANDEL_INSTRUMENT
+/**
+ * @brief Writes the statistics of the last run of an instrumented calculator
+ */
+static void dumpInstrumentation(const MandelInstrumentation &instr, const std::string &name, unsigned size, unsigned limit,
+                                const Options &opts)
+{
+	if (opts.instrumentPrefix.empty()) return;
+
+	const std::string prefix = opts.instrumentPrefix + "_" + name + "_" + std::to_string(size) + "_" + std::to_string(limit);
+	if (!instr.dump(prefix))
+		std::cerr << "mandel_benchmark: can not write instrumentation " << prefix << "_*.csv" << std::endl;
+}
+#endif
+
+/**
+ * @brief Creates the calculator given by its name and benchmarks it
+ */
+static Result run(const std::string &name, unsigned size, unsigned limit, const Options &opts, PerfCounters &counters)
+{
+	if (name == "ref")          { RefMandelCalculator calc(size, limit);           return benchmark(calc, opts, counters); }
+#ifdef MANDEL_INSTRUMENT
+	if (name == "line")  { LineMandelCalculator calc(size, limit);  Result r = benchmark(calc, opts, counters); dumpInstrumentation(calc.instrumentation(), name, size, limit, opts); return r; }
+	if (name == "batch") { BatchMandelCalculator calc(size, limit); Result r = benchmark(calc, opts, counters); dumpInstrumentation(calc.instrumentation(), name, size, limit, opts); return r; }
+#endif
+	if (name == "line")         { LineMandelCalculator calc(size, limit);          return benchmark(calc, opts, counters); }
+	if (name == "batch")        { BatchMandelCalculator calc(size, limit);         return benchmark(calc, opts, counters); }
+	if (name == "simd")         { SimdMandelCalculator calc(size, limit);          return benchmark(calc, opts, counters); }
+	if (name == "tiled")        { TiledMandelCalculator calc(size, limit);         return benchmark(calc, opts, counters); }
+	if (name == "tiled-numa")   { TiledMandelCalculator calc(size, limit, true);   return benchmark(calc, opts, counters); }
+	if (name == "mariani")      { MarianiSilverMandelCalculator calc(size, limit); return benchmark(calc, opts, counters); }
+	if (name == "perturbation") { PerturbationMandelCalculator calc(size, limit);  return benchmark(calc, opts, counters); }
+	if (name == "refill")       { RefillMandelCalculator calc(size, limit);        return benchmark(calc, opts, counters); }
+	if (name == "compact")      { CompactMandelCalculator calc(size, limit);       return benchmark(calc, opts, counters); }
+
+	throw std::invalid_argument("unknown calculator '" + name + "'");
+}
+
+
+static std::vector<std::string> splitList(const std::string &str)
+{
+	std::vector<std::string> items;
+	std::stringstream ss(str);
+	std::string item;
+	while (std::getline(ss, item, ','))
+		if (!item.empty()) items.push_back(item);
+	return items;
+}
+
+static std::vector<unsigned> splitNumbers(const std::string &str)
+{
+	std::vector<unsigned> numbers;
+	for (const std::string &item : splitList(str))
+		numbers.push_back(std::stoul(item));
+	return numbers;
+}
+
+static Options parseOptions(int argc, char *argv[])
+{
+	Options opts;
+	for (int a = 1; a < argc; ++a){
+		const std::string arg = argv[a];
+		const bool hasValue = a + 1 < argc;
+
+		if (arg == "--shortcuts")                   opts.shortcuts = true;
+		else if (arg == "--calc" && hasValue)       opts.calculators = splitList(argv[++a]);
+		else if (arg == "--size" && hasValue)       opts.sizes = splitNumbers(argv[++a]);
+		else if (arg == "--limit" && hasValue)      opts.limits = splitNumbers(argv[++a]);
+		else if (arg == "--warmup" && hasValue)     opts.warmup = std::stoi(argv[++a]);
+		else if (arg == "--repeat" && hasValue)     opts.repeat = std::max(1, std::stoi(argv[++a]));
+		else if (arg == "--save" && hasValue)       opts.saveFile = argv[++a];
+		else if (arg == "--baseline" && hasValue)   opts.baselineFile = argv[++a];
+		else if (arg == "--tolerance" && hasValue)  opts.tolerance = std::stod(argv[++a]);
+		else if (arg == "--pin" && hasValue)        opts.pinning = NumaTopology::parsePinning(argv[++a]);
+		else if (arg == "--instrument" && hasValue) opts.instrumentPrefix = argv[++a];
+		else throw std::invalid_argument("unknown or incomplete option '" + arg + "'");
+	}
+	return opts;
+}
+
+/**
+ * @brief Name of the calculator without the variant in brackets (e.g. "SimdMandelCalculator[AVX-512]")
+ */
+static std::string baseName(const std::string &name)
+{
+	return name.substr(0, name.find('['));
+}
+
+/**
+ * @brief Section line of the runs of this machine in the baseline file ("# machine;<cpu model>;<threads>")
+ */
+static std::string machineLine()
+{
+	return "# machine;" + BlockProfile::cpuModel() + ";" + std::to_string(omp_get_max_threads());
+}
+
+/**
+ * @brief Reads median times of the baseline section of this machine (output of previous runs), the key is name
+ * without variant;base size;limit
+ */
+static std::map<std::string, double> loadBaseline(const std::string &file)
+{
+	std::ifstream in(file);
+	if (!in)
+		throw std::runtime_error("can not open baseline '" + file + "'");
+
+	const std::string machine = machineLine();
+	std::map<std::string, double> baseline;
+	std::string line;
+	bool ownSection = false;
+	while (std::getline(in, line)){
+		if (line.rfind("# machine;", 0) == 0) ownSection = (line == machine);
+		if (!ownSection || line.empty() || line[0] == '#' || line.rfind("calculator;", 0) == 0) continue;
+
+		std::vector<std::string> cols;
+		std::stringstream ss(line);
+		std::string col;
+		while (std::getline(ss, col, ';'))
+			cols.push_back(col);
+		if (cols.size() < 6) continue;
+
+		baseline[baseName(cols[0]) + ";" + cols[1] + ";" + cols[4]] = std::stod(cols[5]);
+	}
+
+	// Timings of another CPU (or thread count) would report false regressions
+	if (baseline.empty())
+		throw std::runtime_error("baseline '" + file + "' has no runs of this machine (" + BlockProfile::cpuModel() + ", "
+		                         + std::to_string(omp_get_max_threads()) + " threads), record them with --save");
+	return baseline;
+}
+
+
+int main(int argc, char *argv[])
+{
+	Options opts;
+	std::map<std::string, double> baseline;
+	try {
+		opts = parseOptions(argc, argv);
+		if (!opts.baselineFile.empty())
+			baseline = loadBaseline(opts.baselineFile);
+	} catch (const std::exception &e) {
+		std::cerr << "mandel_benchmark: " << e.what() << std::endl;
+		return 1;
+	}
+
+	// Threads of the pool are pinned before the numa-aware calculators first-touch their images
+	if (opts.pinning != ThreadPinning::NONE && !NumaTopology::pinThreads(opts.pinning))
+		std::cerr << "mandel_benchmark: threads could not be pinned (" << NumaTopology::pinningName(opts.pinning) << ")" << std::endl;
+
+	// Counters have to be opened before the calculators start using the thread pool
+	PerfCounters counters;
+	if (!counters.available())
+		std::cerr << "mandel_benchmark: perf_event_open is not permitted, hardware counters are reported as -1" << std::endl;
+
+	std::ofstream save;
+	if (!opts.saveFile.empty())
+		save.open(opts.saveFile, std::ios::app);
+
+	const std::string header = "calculator;base;width;height;limit;time_ms;gflops;cycles_per_pixel;ipc;cache_misses;node_image_gbps";
+	std::cout << header << std::endl;
+	if (save) save << machineLine() << std::endl << header << std::endl;
+
+	int regressions = 0;
+	for (const std::string &name : opts.calculators){
+		for (unsigned size : opts.sizes){
+			for (unsigned limit : opts.limits){
+				Result result;
+				try {
+					result = run(name, size, limit, opts, counters);
+				} catch (const std::exception &e) {
+					std::cerr << "mandel_benchmark: " << name << " " << size << " " << limit << ": " << e.what() << std::endl;
+					continue;
+				}
+				result.key = baseName(result.info.substr(0, result.info.find(';'))) + ";" + std::to_string(size) + ";" + std::to_string(limit);
+
+				std::ostringstream row;
+				row << result.info << result.timeMs << ";" << result.gflops << ";" << result.cyclesPerPixel << ";" << result.ipc << ";" << result.cacheMisses
+				    << ";" << result.nodeImageRate;
+				std::cout << row.str();
+				if (save) save << row.str() << std::endl;
+
+				// Comparison with the baseline (runs missing in the baseline are only reported)
+				if (!baseline.empty()){
+					auto it = baseline.find(result.key);
+					if (it == baseline.end()){
+						std::cout << ";NEW";
+					} else {
+						const double ratio = result.timeMs / it->second;
+						const bool regression = ratio > 1.0 + opts.tolerance;
+						regressions += regression;
+						std::cout << ";" << (regression ? "REGRESSION" : "OK") << "(" << ratio << "x)";
+					}
+				}
+				std::cout << std::endl;
+			}
+		}
+	}
+
+	if (regressions > 0){
+		std::cerr << "mandel_benchmark: " << regressions << " regression(s) against " << opts.baselineFile << std::endl;
+		return 2;
+	}
+	return 0;
+}
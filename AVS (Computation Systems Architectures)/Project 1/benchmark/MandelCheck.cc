@@ -0,0 +1,272 @@
+/**
+ * @file MandelCheck.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Check of the Mandelbrot calculators against the reference (every calculator, formula, shortcut and viewport)
+ * @date 17.10.2026
+ *
+ * Build (from Project 1, the flags of the course, i.e. GCC contracts into FMAs by default):
+ *   g++ -std=c++17 -O3 -march=native -fopenmp -Icalculators benchmark/MandelCheck.cc calculators/[A-Z]*.cc -o mandel_check
+ *
+ * Usage:
+ *   mandel_check [--calc line,batch,...] [--size 64] [--limit 200,1000]
+ *
+ * Every calculator is compared with RefMandelCalculator set up the same way, combinations the calculator refuses
+ * (setFormula() / setInteriorShortcuts() return false) are skipped. Output is CSV (';' separated): calculator, formula,
+ * shortcuts, viewport, size, limit and the number of differing pixels. The exit code is 1 if any calculator differs.
+ *
+ * The kernels stop at |z|^2 >= bailout, the reference at |z|^2 > bailout, so a pixel whose orbit hits the bailout
+ * exactly is counted differently and is not reported (the tie is verified by iterating the pixel again). The
+ * perturbation calculator iterates deltas against a double-double reference orbit (in double also where the reference
+ * iterates in float), the chaotic pixels near the boundary of the set may escape a few iterations apart, it is accepted
+ * with PERTURBATION_TOLERANCE of the pixels differing.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "RefMandelCalculator.h"
+#include "LineMandelCalculator.h"
+#include "BatchMandelCalculator.h"
+#include "SimdMandelCalculator.h"
+#include "TiledMandelCalculator.h"
+#include "MarianiSilverMandelCalculator.h"
+#include "PerturbationMandelCalculator.h"
+#include "RefillMandelCalculator.h"
+#include "CompactMandelCalculator.h"
+#include "AntialiasedMandelCalculator.h"
+#include "ProgressiveMandelCalculator.h"
+#include "FrameSequenceRenderer.h"
+
+// Ties are iterated again the same way as the reference does it
+#include "FpContract.h"
+
+// Fraction of pixels the perturbation calculator may count differently
+static const double PERTURBATION_TOLERANCE = 0.01;
+
+
+struct Viewport
+{
+	std::string name;
+	double centerReal;
+	double centerImag;
+	double scale;
+};
+
+struct Options
+{
+	std::vector<std::string> calculators = {"line", "batch", "simd", "tiled", "tiled-numa", "mariani", "perturbation",
+	                                        "refill", "compact", "compact-full", "antialiased", "progressive", "sequence"};
+	std::vector<unsigned> sizes = {64};
+	std::vector<unsigned> limits = {200, 1000};
+};
+
+/**
+ * @brief Reference calculator that also gives the coordinates of its pixels
+ */
+class ProbeCalculator : public RefMandelCalculator
+{
+public:
+	using RefMandelCalculator::RefMandelCalculator;
+
+	double pixelReal(int j) const { return x_start + j * dx; }
+	double pixelImag(int i) const { return y_start + i * dy; }
+};
+
+template <typename T, class Formula>
+static bool hitsBailout(const Formula &f, T x, T y, int count)
+{
+	T zReal = x;
+	T zImag = y;
+	for (int i = 0; i < count; ++i)
+		f.step(zReal, zImag, x, y);
+	return zReal * zReal + zImag * zImag == T(f.bailout());
+}
+
+/**
+ * @brief True if the kernels stop at count because |z|^2 equals the bailout there (the reference iterates further)
+ */
+template <typename T>
+static bool bailoutTie(const FractalFormula &formula, T x, T y, int count)
+{
+	switch (formula.kind)
+	{
+	case FractalFormula::MULTIBROT3:   return hitsBailout(Formulas::Multibrot<3>(), x, y, count);
+	case FractalFormula::MULTIBROT4:   return hitsBailout(Formulas::Multibrot<4>(), x, y, count);
+	case FractalFormula::JULIA:        return hitsBailout(formula.juliaPolicy(), x, y, count);
+	case FractalFormula::BURNING_SHIP: return hitsBailout(Formulas::BurningShip(), x, y, count);
+	default:                           return hitsBailout(Formulas::Mandelbrot(), x, y, count);
+	}
+}
+
+/**
+ * @brief Number of pixels of data that differ from the reference (ties at the bailout excluded)
+ */
+static long countDifferences(const ProbeCalculator &ref, const int *expected, const int *data, const FractalFormula &formula)
+{
+	long differences = 0;
+	for (int i = 0; i < ref.height; ++i){
+		for (int j = 0; j < ref.width; ++j){
+			const int want = expected[i * ref.width + j];
+			const int got = data[i * ref.width + j];
+			if (got == want) continue;
+
+			const bool tie = got < want && (ref.needsDoublePrecision()
+				? bailoutTie<double>(formula, ref.pixelReal(j), ref.pixelImag(i), got)
+				: bailoutTie<float>(formula, ref.pixelReal(j), ref.pixelImag(i), got));
+			differences += !tie;
+		}
+	}
+	return differences;
+}
+
+/**
+ * @brief Sets the calculator up like the reference, returns -1 if it refuses the combination, otherwise the number
+ * of differing pixels
+ */
+template <typename Calc>
+static long check(Calc &calc, const ProbeCalculator &ref, const int *expected, const FractalFormula &formula,
+                  bool bulbTest, bool periodicityTest, const Viewport &view)
+{
+	if (!calc.setFormula(formula) || !calc.setInteriorShortcuts(bulbTest, periodicityTest))
+		return -1;
+	calc.setViewport(view.centerReal, view.centerImag, view.scale);
+
+	return countDifferences(ref, expected, calc.calculateMandelbrot(), formula);
+}
+
+/**
+ * @brief Creates the calculator given by its name and checks it
+ */
+static long run(const std::string &name, unsigned size, unsigned limit, const ProbeCalculator &ref, const int *expected,
+                const FractalFormula &formula, bool bulbTest, bool periodicityTest, const Viewport &view)
+{
+	// Antialiased with the threshold above the limit finds no edges, so it must be identical to the reference
+	if (name == "line")         { LineMandelCalculator calc(size, limit);                   return check(calc, ref, expected, formula, bulbTest, periodicityTest, view); }
+	if (name == "batch")        { BatchMandelCalculator calc(size, limit);                  return check(calc, ref, expected, formula, bulbTest, periodicityTest, view); }
+	if (name == "simd")         { SimdMandelCalculator calc(size, limit);                   return check(calc, ref, expected, formula, bulbTest, periodicityTest, view); }
+	if (name == "tiled")        { TiledMandelCalculator calc(size, limit);                  return check(calc, ref, expected, formula, bulbTest, periodicityTest, view); }
+	if (name == "tiled-numa")   { TiledMandelCalculator calc(size, limit, true);            return check(calc, ref, expected, formula, bulbTest, periodicityTest, view); }
+	if (name == "mariani")      { MarianiSilverMandelCalculator calc(size, limit);          return check(calc, ref, expected, formula, bulbTest, periodicityTest, view); }
+	if (name == "perturbation") { PerturbationMandelCalculator calc(size, limit);           return check(calc, ref, expected, formula, bulbTest, periodicityTest, view); }
+	if (name == "refill")       { RefillMandelCalculator calc(size, limit);                 return check(calc, ref, expected, formula, bulbTest, periodicityTest, view); }
+	if (name == "compact")      { CompactMandelCalculator calc(size, limit);                return check(calc, ref, expected, formula, bulbTest, periodicityTest, view); }
+	if (name == "compact-full") { CompactMandelCalculator calc(size, limit, false);         return check(calc, ref, expected, formula, bulbTest, periodicityTest, view); }
+	if (name == "antialiased")  { AntialiasedMandelCalculator calc(size, limit, 8, limit);  return check(calc, ref, expected, formula, bulbTest, periodicityTest, view); }
+	if (name == "progressive")  { ProgressiveMandelCalculator calc(size, limit);            return check(calc, ref, expected, formula, bulbTest, periodicityTest, view); }
+	if (name == "sequence")     { FrameSequenceRenderer calc(size, limit);                  return check(calc, ref, expected, formula, bulbTest, periodicityTest, view); }
+
+	throw std::invalid_argument("unknown calculator '" + name + "'");
+}
+
+
+static std::vector<std::string> splitList(const std::string &str)
+{
+	std::vector<std::string> items;
+	std::stringstream ss(str);
+	std::string item;
+	while (std::getline(ss, item, ','))
+		if (!item.empty()) items.push_back(item);
+	return items;
+}
+
+static std::vector<unsigned> splitNumbers(const std::string &str)
+{
+	std::vector<unsigned> numbers;
+	for (const std::string &item : splitList(str))
+		numbers.push_back(std::stoul(item));
+	return numbers;
+}
+
+static Options parseOptions(int argc, char *argv[])
+{
+	Options opts;
+	for (int a = 1; a < argc; ++a){
+		const std::string arg = argv[a];
+		const bool hasValue = a + 1 < argc;
+
+		if (arg == "--calc" && hasValue)       opts.calculators = splitList(argv[++a]);
+		else if (arg == "--size" && hasValue)  opts.sizes = splitNumbers(argv[++a]);
+		else if (arg == "--limit" && hasValue) opts.limits = splitNumbers(argv[++a]);
+		else throw std::invalid_argument("unknown or incomplete option '" + arg + "'");
+	}
+	return opts;
+}
+
+
+int main(int argc, char *argv[])
+{
+	Options opts;
+	try {
+		opts = parseOptions(argc, argv);
+	} catch (const std::exception &e) {
+		std::cerr << "mandel_check: " << e.what() << std::endl;
+		return 1;
+	}
+
+	// Symmetric default view (mirrored halves), off-axis view (no mirroring) and a zoom that needs double kernels
+	const std::vector<Viewport> views = {
+		{"default", -0.5, 0.0, 3.0},
+		{"offaxis", -0.75, 0.1, 0.5},
+		{"deep", -0.743643887037151, 0.131825904205330, 1e-5},
+	};
+	const std::vector<FractalFormula> formulas = {
+		FractalFormula::mandelbrot(), FractalFormula::multibrot(3), FractalFormula::multibrot(4),
+		FractalFormula::julia(-0.8, 0.156), FractalFormula::julia(-0.4, 0.0), FractalFormula::burningShip(),
+	};
+
+	std::cout << "calculator;formula;shortcuts;viewport;base;limit;differences" << std::endl;
+
+	int failures = 0;
+	for (unsigned size : opts.sizes){
+		for (unsigned limit : opts.limits){
+			for (const Viewport &view : views){
+				for (const FractalFormula &formula : formulas){
+					for (int shortcuts = 0; shortcuts < 4; ++shortcuts){
+						const bool bulbTest = shortcuts & 1;
+						const bool periodicityTest = shortcuts & 2;
+
+						// Shortcuts are applied only to the Mandelbrot set, other formulas would repeat the same run
+						if (shortcuts != 0 && formula.kind != FractalFormula::MANDELBROT) continue;
+
+						ProbeCalculator ref(size, limit);
+						ref.setFormula(formula);
+						ref.setInteriorShortcuts(bulbTest, periodicityTest);
+						ref.setViewport(view.centerReal, view.centerImag, view.scale);
+						const int *expected = ref.calculateMandelbrot();
+
+						const std::string shortcutName = std::string(bulbTest ? "bulb" : "") + (shortcuts == 3 ? "," : "")
+						                               + (periodicityTest ? "period" : "") + (shortcuts == 0 ? "none" : "");
+
+						for (const std::string &name : opts.calculators){
+							long differences;
+							try {
+								differences = run(name, size, limit, ref, expected, formula, bulbTest, periodicityTest, view);
+							} catch (const std::exception &e) {
+								std::cerr << "mandel_check: " << name << ": " << e.what() << std::endl;
+								++failures;
+								continue;
+							}
+							if (differences < 0) continue;
+
+							const long allowed = (name == "perturbation") ? long(PERTURBATION_TOLERANCE * ref.width * ref.height) : 0;
+							const bool failed = differences > allowed;
+							failures += failed;
+
+							std::cout << name << ";" << formula.name() << ";" << shortcutName << ";" << view.name << ";" << size << ";"
+							          << limit << ";" << differences << (failed ? ";FAILED" : "") << std::endl;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	if (failures > 0){
+		std::cerr << "mandel_check: " << failures << " check(s) differ from the reference" << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file PerfCounters.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Hardware counters (cycles, instructions, cache misses) of all OpenMP threads read through perf_event_open
+ * @date 17.10.2026
+ */
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <omp.h>
+
+/**
+ * @brief Counts user-space events of the OpenMP thread pool between start() and stop()
+ *
+ * One counter per event and thread is opened (inherited counters of the still running pool threads would not be
+ * summed), so the calculators have to use the default pool (libgomp reuses its threads). If perf_event_open is not
+ * permitted (perf_event_paranoid, containers), available() is false and all values are -1.
+ */
+class PerfCounters
+{
+public:
+    enum Event { CYCLES, INSTRUCTIONS, CACHE_MISSES, EVENT_COUNT };
+
+    PerfCounters()
+    {
+        // Thread ids of the pool, the parallel region also creates the pool before the calculators do
+        std::vector<pid_t> tids(omp_get_max_threads(), -1);
+        #pragma omp parallel
+        tids[omp_get_thread_num()] = (pid_t)syscall(SYS_gettid);
+
+        static const uint64_t configs[EVENT_COUNT] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES
+        };
+
+        for (int e = 0; e < EVENT_COUNT; ++e)
+        {
+            for (pid_t tid : tids)
+            {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = configs[e];
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+
+                int fd = (tid < 0) ? -1 : (int)syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0);
+                if (fd < 0)
+                {
+                    close();
+                    return;
+                }
+                fds[e].push_back(fd);
+            }
+        }
+    }
+
+    ~PerfCounters() { close(); }
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    /**
+     * @brief True if all counters were opened
+     */
+    bool available() const { return !fds[0].empty(); }
+
+    /**
+     * @brief Resets and enables the counters
+     */
+    void start()
+    {
+        for (int e = 0; e < EVENT_COUNT; ++e)
+        {
+            for (int fd : fds[e])
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    /**
+     * @brief Disables the counters and stores their sums over the threads
+     */
+    void stop()
+    {
+        for (int e = 0; e < EVENT_COUNT; ++e)
+        {
+            values[e] = available() ? 0 : -1;
+            for (int fd : fds[e])
+            {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+                uint64_t count = 0;
+                if (read(fd, &count, sizeof(count)) == sizeof(count))
+                    values[e] += (long long)count;
+            }
+        }
+    }
+
+    /**
+     * @brief Value of the event measured by the last start() / stop() (-1 = not available)
+     */
+    long long value(Event event) const { return values[event]; }
+
+private:
+    void close()
+    {
+        for (int e = 0; e < EVENT_COUNT; ++e)
+        {
+            for (int fd : fds[e])
+                ::close(fd);
+            fds[e].clear();
+            values[e] = -1;
+        }
+    }
+
+    std::vector<int> fds[EVENT_COUNT]; // counters of the threads for each event
+    long long values[EVENT_COUNT] = {-1, -1, -1};
+};
+
+#endif
@@ -0,0 +1,184 @@
+/**
+ * @file AntialiasedMandelCalculator.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator with adaptive supersampling of the high-gradient pixels
+ * @date 17.10.2026
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <cstdlib>
+
+#include <stdlib.h>
+
+#include <immintrin.h>	// _mm_malloc()
+#include <cstring>	    // memcpy()
+#include <omp.h>
+
+#include "MandelKernels.h"
+#include "AntialiasedMandelCalculator.h"
+
+
+AntialiasedMandelCalculator::AntialiasedMandelCalculator (unsigned matrixBaseSize, unsigned limit, int samples, int threshold) :
+	BaseMandelCalculator(matrixBaseSize, limit, "AntialiasedMandelCalculator"), samples(samples), threshold(threshold), lastResampled(0)
+{
+	formulasSupported = true;
+	if (samples < 1 || threshold < 0)
+		throw std::invalid_argument("AntialiasedMandelCalculator: samples have to be positive and threshold non-negative");
+
+	data = (int*)(_mm_malloc(height * width * sizeof(int), 64));
+	edges = (uint8_t*)(_mm_malloc(height * width * sizeof(uint8_t), 64));
+
+	threads = omp_get_max_threads();
+	for (int t = 0; t < threads; ++t){
+		crBuffers.emplace_back(width * samples);
+		ciBuffers.emplace_back(width * samples);
+		outBuffers.push_back((int*)(_mm_malloc(width * samples * sizeof(int), 64)));
+		rBuffers.emplace_back(MandelKernels::blockSize);
+		iBuffers.emplace_back(MandelKernels::blockSize);
+	}
+
+	cVariant = "aa" + std::to_string(samples) + ",t" + std::to_string(threshold);
+}
+
+AntialiasedMandelCalculator::~AntialiasedMandelCalculator() {
+	_mm_free(data);
+	_mm_free(edges);
+	data = nullptr;
+	edges = nullptr;
+	for (int t = 0; t < threads; ++t){
+		_mm_free(outBuffers[t]);
+	}
+	outBuffers.clear();
+}
+
+
+/**
+ * @brief Sub-pixel offset in [-0.5, 0.5) given by a hash of the pixel and the sample, so frames are reproducible
+ */
+static inline double jitter(uint32_t pixel, uint32_t sample)
+{
+	uint32_t h = pixel * 0x9E3779B1u ^ (sample + 1) * 0x85EBCA77u;
+	h ^= h >> 15;
+	h *= 0x2C1B3C6Du;
+	h ^= h >> 12;
+	h *= 0x297A2D39u;
+	h ^= h >> 15;
+	return h / 4294967296.0 - 0.5;
+}
+
+
+int * AntialiasedMandelCalculator::calculateMandelbrot () {
+
+	// Float kernels are used while the pixel spacing allows it
+	return needsDoublePrecision() ? dispatch<double>() : dispatch<float>();
+}
+
+
+template <typename T>
+int * AntialiasedMandelCalculator::dispatch () {
+
+	switch (formula.kind){
+		case FractalFormula::MULTIBROT3:   return calculate<T>(Formulas::Multibrot<3>());
+		case FractalFormula::MULTIBROT4:   return calculate<T>(Formulas::Multibrot<4>());
+		case FractalFormula::JULIA:        return calculate<T>(formula.juliaPolicy());
+		case FractalFormula::BURNING_SHIP: return calculate<T>(Formulas::BurningShip());
+		default:                           return calculate<T>(Formulas::Mandelbrot());
+	}
+}
+
+
+template <typename T, class Formula>
+int * AntialiasedMandelCalculator::calculate (const Formula &f) {
+
+	// Due to symmetricity just half of the rows is computed and resampled, the rest is mirrored
+	const bool symmetric = isSymmetric();
+	const int rows = symmetric ? height / 2 : height;
+
+	long resampled = 0;
+
+	#pragma omp parallel num_threads(threads) reduction(+:resampled)
+	{
+		const int thread = omp_get_thread_num();
+		T *rBuffer = rBuffers[thread].as<T>();
+		T *iBuffer = iBuffers[thread].as<T>();
+
+		// First pass, one sample per pixel
+		#pragma omp for schedule(dynamic, 8)
+		for (int i = 0; i < rows; i++){
+			int *pdata = data + i * width;
+			const T y = y_start + i * dy;
+			MandelKernels::row(pdata, 0, width, x_start, dx, y, limit, rBuffer, iBuffer, f);
+
+			// Copy the row to next half of the image
+			if (symmetric)
+				std::memcpy(data + (height-i-1) * width, pdata, width * sizeof(int));
+		}
+
+		// Edges are detected on the whole first pass, before any pixel is replaced
+		#pragma omp for schedule(static)
+		for (int i = 0; i < rows; i++){
+			const int *pdata = data + i * width;
+			const int *pup = (i > 0) ? pdata - width : pdata;
+			const int *pdown = (i < height - 1) ? pdata + width : pdata;
+			uint8_t *pedges = edges + i * width;
+
+			#pragma omp simd
+			for (int j = 0; j < width; j++){
+				const int n = pdata[j];
+				const int left = pdata[std::max(j - 1, 0)];
+				const int right = pdata[std::min(j + 1, width - 1)];
+				const int diff = std::max(std::max(std::abs(n - left), std::abs(n - right)),
+				                          std::max(std::abs(n - pup[j]), std::abs(n - pdown[j])));
+				pedges[j] = diff > threshold;
+			}
+		}
+
+		// Samples of all edge pixels of a row are packed into the lanes of one kernel call
+		T *cr = crBuffers[thread].as<T>();
+		T *ci = ciBuffers[thread].as<T>();
+		int *out = outBuffers[thread];
+
+		#pragma omp for schedule(dynamic, 8)
+		for (int i = 0; i < rows; i++){
+			int *pdata = data + i * width;
+			const uint8_t *pedges = edges + i * width;
+
+			int count = 0;
+			for (int j = 0; j < width; j++){
+				if (!pedges[j]) continue;
+
+				const uint32_t pixel = uint32_t(i * width + j);
+				for (int s = 0; s < samples; s++){
+					cr[count] = x_start + (j + jitter(pixel, 2 * s)) * dx;
+					ci[count] = y_start + (i + jitter(pixel, 2 * s + 1)) * dy;
+					++count;
+				}
+			}
+			if (count == 0) continue;
+
+			MandelKernels::points(cr, ci, out, count, limit, rBuffer, iBuffer, f);
+
+			int k = 0;
+			for (int j = 0; j < width; j++){
+				if (!pedges[j]) continue;
+
+				int sum = pdata[j];
+				for (int s = 0; s < samples; s++)
+					sum += out[k++];
+				pdata[j] = (sum + (samples + 1) / 2) / (samples + 1);
+			}
+			resampled += (symmetric ? 2 : 1) * (count / samples);
+
+			if (symmetric)
+				std::memcpy(data + (height-i-1) * width, pdata, width * sizeof(int));
+		}
+	}
+
+	lastResampled = resampled;
+	return data;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file AntialiasedMandelCalculator.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator with adaptive supersampling of the high-gradient pixels
+ * @date 17.10.2026
+ */
+#ifndef ANTIALIASEDMANDELCALCULATOR_H
+#define ANTIALIASEDMANDELCALCULATOR_H
+
+#include <vector>
+#include <cstdint>
+
+#include <BaseMandelCalculator.h>
+#include "ScratchBuffer.h"
+
+class AntialiasedMandelCalculator : public BaseMandelCalculator
+{
+public:
+    /**
+     * @brief Construct a new Antialiased Mandel Calculator object
+     *
+     * @param matrixBaseSize basic size (width will be multiplied by 3, height by 2)
+     * @param limit number of iterations
+     * @param samples jittered sub-pixel samples added to an edge pixel
+     * @param threshold pixel is an edge if the count of a 4-neighbour differs by more than threshold
+     */
+    AntialiasedMandelCalculator(unsigned matrixBaseSize, unsigned limit, int samples = 8, int threshold = 2);
+    ~AntialiasedMandelCalculator();
+
+    /**
+     * @brief Computes the image, counts of the edge pixels are the rounded mean of the pixel and its samples
+     */
+    int *calculateMandelbrot();
+
+    /**
+     * @brief Number of pixels resampled by the last calculation (including the mirrored ones)
+     */
+    long resampledPixels() const { return lastResampled; }
+
+private:
+    template <typename T>
+    int *dispatch();
+
+    template <typename T, class Formula>
+    int *calculate(const Formula &f);
+
+    const int samples;
+    const int threshold;
+    long lastResampled;
+
+    int *data;
+    uint8_t *edges; // edge mask of the first pass
+    int threads;
+    // Per-thread buffers of the samples of one row (width * samples elements, allocated for double)
+    std::vector<ScratchBuffer> crBuffers;
+    std::vector<ScratchBuffer> ciBuffers;
+    std::vector<int *> outBuffers;
+    std::vector<ScratchBuffer> rBuffers;
+    std::vector<ScratchBuffer> iBuffers;
+};
+
+#endif
@@ -8,9 +8,13 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <cmath>
 
 #include "BaseMandelCalculator.h"
 
+// Minimal pixel spacing for float kernels, in float ulps of the largest coordinate (float has 24 bit mantissa)
+static const double FLOAT_MIN_PIXEL_ULPS = 16.0;
+
 BaseMandelCalculator::BaseMandelCalculator(unsigned matrixBaseSize, unsigned limit, const std::string &cName)
 	: width(3 * matrixBaseSize), height(2 * matrixBaseSize), x_start(-2.0), x_fin(1.0), y_start(-1.5), y_fin(1.5), limit(limit), cName(cName)
 
@@ -21,9 +25,20 @@ BaseMandelCalculator::BaseMandelCalculator(unsigned matrixBaseSize, unsigned lim
 
 void BaseMandelCalculator::info(std::ostream &cout, bool batchMode)
 {
+	// Only the options the kernels actually apply are reported (the shortcuts are used only for the Mandelbrot set)
+	const bool shortcuts = shortcutsSupported && formula.kind == FractalFormula::MANDELBROT;
+
+	std::string variant = cVariant;
+	if (shortcuts && bulbTest) variant += (variant.empty() ? "" : ",") + std::string("bulb");
+	if (shortcuts && periodicityTest) variant += (variant.empty() ? "" : ",") + std::string("period");
+	if (formula.kind != FractalFormula::MANDELBROT) variant += (variant.empty() ? "" : ",") + formula.name();
+	if (needsDoublePrecision()) variant += (variant.empty() ? "" : ",") + std::string("double");
+
+	const std::string name = variant.empty() ? cName : cName + "[" + variant + "]";
+
 	if (batchMode)
 	{
-		cout << cName << ";";
+		cout << name << ";";
 		cout << width / 3 << ";";
 		cout << width << ";" << height << ";";
 		cout << limit << ";";
@@ -31,9 +46,74 @@ void BaseMandelCalculator::info(std::ostream &cout, bool batchMode)
 	else
 	{
 		cout << "======================== Mandelbrot SIMD calculator ==========================" << std::endl;
-		cout << "Calculator:        " << cName << std::endl;
+		cout << "Calculator:        " << name << std::endl;
 		cout << "Base size:         " << width / 3 << std::endl;
 		cout << "Matrix size:       " << width << "x" << height << std::endl;
 		cout << "Iteration limit:   " << limit << std::endl;
+		cout << "Viewport:          [" << x_start << ", " << x_fin << "] x [" << y_start << ", " << y_fin << "]" << std::endl;
+	}
+}
+
+bool BaseMandelCalculator::setInteriorShortcuts(bool bulbTest, bool periodicityTest)
+{
+	if (!shortcutsSupported && (bulbTest || periodicityTest))
+		return false;
+
+	this->bulbTest = bulbTest;
+	this->periodicityTest = periodicityTest;
+	return true;
+}
+
+bool BaseMandelCalculator::setFormula(const FractalFormula &formula)
+{
+	if (!formulasSupported && formula.kind != FractalFormula::MANDELBROT)
+		return false;
+
+	this->formula = formula;
+	return true;
+}
+
+void BaseMandelCalculator::setViewport(double centerReal, double centerImag, double scale, double aspectRatio)
+{
+	const double halfWidth = scale / 2.0;
+	const double halfHeight = scale * aspectRatio / 2.0;
+
+	x_start = centerReal - halfWidth;
+	x_fin = centerReal + halfWidth;
+	y_start = centerImag - halfHeight;
+	y_fin = centerImag + halfHeight;
+
+	dx = (x_fin - x_start) / (width - 1);
+	dy = (y_fin - y_start) / (height - 1);
+}
+
+bool BaseMandelCalculator::isSymmetric() const
+{
+	// Row i and row (height - 1 - i) have opposite imag values only if the imag range is centered at 0
+	return formula.conjugateSymmetric() && std::abs(y_start + y_fin) <= dy * 1e-6;
+}
+
+void BaseMandelCalculator::computedRows(int &first, int &last, bool &mirror) const
+{
+	// Band rows are stored exactly where they are in the image, nothing is mirrored
+	if (bandEnd >= 0)
+	{
+		first = bandStart;
+		last = bandEnd;
+		mirror = false;
+		return;
 	}
+
+	mirror = isSymmetric();
+	first = 0;
+	last = mirror ? height / 2 : height;
+}
+
+bool BaseMandelCalculator::needsDoublePrecision() const
+{
+	const double floatUlp = std::ldexp(1.0, -23);
+	const double maxReal = std::max(std::abs(x_start), std::abs(x_fin));
+	const double maxImag = std::max(std::abs(y_start), std::abs(y_fin));
+
+	return dx < maxReal * floatUlp * FLOAT_MIN_PIXEL_ULPS || dy < maxImag * floatUlp * FLOAT_MIN_PIXEL_ULPS;
 }
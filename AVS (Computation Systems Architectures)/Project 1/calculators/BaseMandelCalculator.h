@@ -12,6 +12,8 @@
 #include <string>
 #include <iostream>
 
+#include "Formulas.h"
+
 /**
  * @brief Abstract class for Mandelbrot set calculator, calculates the dimensions
  * 
@@ -35,21 +37,89 @@ public:
      * @param batchMode true = compact CSV output
      */
     void info(std::ostream & cout, bool batchMode);
+
+    /**
+     * @brief Enables shortcuts for the points inside the set (supported by Ref, Line and Batch calculators, applied
+     * only to the Mandelbrot set)
+     * 
+     * @param bulbTest points in the main cardioid and the period-2 bulb are set to limit without iterating
+     * @param periodicityTest iteration stops when the orbit returns to a saved point (Brent's cycle detection)
+     * @return false if a shortcut is requested from a calculator that does not support them (nothing is changed)
+     */
+    bool setInteriorShortcuts(bool bulbTest, bool periodicityTest);
+
+    /**
+     * @brief Sets the escape-time formula (supported by Ref, Line, Batch, Tiled, Compact, Antialiased, Progressive
+     * calculators and FrameSequenceRenderer, the default is the Mandelbrot set), interior shortcuts are applied only
+     * to the Mandelbrot set
+     * 
+     * @param formula formula and its parameters (e.g. FractalFormula::julia(-0.8, 0.156))
+     * @return false if the calculator supports only the Mandelbrot set and another formula is requested (nothing
+     * is changed)
+     */
+    bool setFormula(const FractalFormula &formula);
+
+    /**
+     * @brief Sets the rendered part of the complex plane (the default is center -0.5+0i, scale 3, aspect ratio 1)
+     * 
+     * @param centerReal real value of the center
+     * @param centerImag imag value of the center
+     * @param scale width of the viewport (range of real values)
+     * @param aspectRatio height of the viewport divided by its width
+     */
+    void setViewport(double centerReal, double centerImag, double scale, double aspectRatio = 1.0);
+
+    /**
+     * @brief True if the rows are symmetric about the real axis (the bottom half can be mirrored), requires
+     * the viewport centered on the real axis and a conjugate-symmetric formula
+     */
+    bool isSymmetric() const;
+
+    /**
+     * @brief True if the pixel spacing is too small for float kernels
+     */
+    bool needsDoublePrecision() const;
+
+    /**
+     * @brief Analytic test of the main cardioid and the period-2 bulb (both are inside the set)
+     */
+    template <typename T>
+    static inline bool isInsideBulb(T x, T y)
+    {
+        T xq = x - T(0.25);
+        T q = xq * xq + y * y;
+        T xb = x + T(1.0);
+        return (q * (q + xq) <= T(0.25) * y * y) | (xb * xb + y * y <= T(0.0625));
+    }
     
     int width; // width of the set
     int height; // hegiht of the set
 
 
 protected:
+    /**
+     * @brief Rows computed by the kernels: the band of calculateRows() (calculators that support it), otherwise the
+     * whole image, or its upper half if the viewport is symmetric (mirror = true, the rest is mirrored)
+     */
+    void computedRows(int &first, int &last, bool &mirror) const;
+
     const std::string cName;
+    std::string cVariant; // optional kernel variant reported next to the name (e.g. selected ISA)
+    bool shortcutsSupported = false; // set by the calculators whose kernels honour setInteriorShortcuts()
+    bool formulasSupported = false;  // set by the calculators whose kernels honour setFormula()
     const int limit;
     bool batchMode;
+    bool bulbTest = false; // skip points in the main cardioid and the period-2 bulb
+    bool periodicityTest = false; // detect cycles of the orbit
+    FractalFormula formula; // iterated formula (dispatched to Formulas:: policies by the calculators)
+    int bandStart = 0; // rows [bandStart, bandEnd) of calculateRows(), bandEnd < 0 = whole image
+    int bandEnd = -1;
 
 
-	const double x_start; // minimal real value
-	const double x_fin; // maximal real value
-	const double y_start; // minimal imag value
-	const double y_fin; // maximal imag value
+	double x_start; // minimal real value
+	double x_fin; // maximal real value
+	double y_start; // minimal imag value
+	double y_fin; // maximal imag value
 	
     double dx; // step of real vaues
 	double dy; // step of imag values
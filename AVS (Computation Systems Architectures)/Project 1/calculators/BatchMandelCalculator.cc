@@ -12,82 +12,251 @@
 
 #include <stdlib.h>
 #include <stdexcept>
+#include <type_traits>
 
 #include <immintrin.h>	// _mm_malloc()
 #include <cstring>	    // memcpy()
 
+#include "MandelKernels.h"
 #include "BatchMandelCalculator.h"
 
 BatchMandelCalculator::BatchMandelCalculator (unsigned matrixBaseSize, unsigned limit) :
 	BaseMandelCalculator(matrixBaseSize, limit, "BatchMandelCalculator")
 {
+	shortcutsSupported = true;
+	formulasSupported = true;
+	setBlockProfile(BlockProfile::load());
+
 	data = (int*)(_mm_malloc(height * width * sizeof(int), 64));
-	rBuffer = (float*)(_mm_malloc(width * sizeof(float), 64));
-	iBuffer = (float*)(_mm_malloc(width * sizeof(float), 64));
+	// Buffers are large enough for the double precision kernels
+	rBuffer = ScratchBuffer(width);
+	iBuffer = ScratchBuffer(width);
+	prBuffer = ScratchBuffer(width);
+	piBuffer = ScratchBuffer(width);
 }
 
 BatchMandelCalculator::~BatchMandelCalculator() {
 	_mm_free(data);
-	_mm_free(rBuffer);
-	_mm_free(iBuffer);
 	data = nullptr;
-	rBuffer = nullptr;
-	iBuffer = nullptr;
+}
+
+
+void BatchMandelCalculator::setBlockProfile(const BlockProfile &profile) {
+
+	this->profile = profile.isSupported() ? profile : BlockProfile();
+
+	// Default profile is not reported, so the name stays the same on machines without a profile
+	const BlockProfile defaults;
+	cVariant.clear();
+	if (this->profile.blockSize != defaults.blockSize || this->profile.unroll != defaults.unroll)
+		cVariant = "b" + std::to_string(this->profile.blockSize) + ",u" + std::to_string(this->profile.unroll);
 }
 
 
 int * BatchMandelCalculator::calculateMandelbrot () {
 
-	// initialize data (there can also be loop over the data with #pragma omp simd, but the efficiency is the same)
-	std::memset(data, 0, height * width * sizeof(int));
+	// Float kernels are used while the pixel spacing allows it
+	return needsDoublePrecision() ? dispatch<double>() : dispatch<float>();
+}
+
+
+int * BatchMandelCalculator::calculateRows (int rowStart, int rowEnd) {
+
+	if (rowStart < 0 || rowEnd > height || rowStart > rowEnd)
+		throw std::invalid_argument("BatchMandelCalculator: invalid band of rows [" + std::to_string(rowStart) + ", " + std::to_string(rowEnd) + ")");
+
+	bandStart = rowStart;
+	bandEnd = rowEnd;
+	int *result = calculateMandelbrot();
+	bandEnd = -1;
+	return result;
+}
+
+
+template <typename T>
+int * BatchMandelCalculator::dispatch () {
+
+	// Shortcuts are valid only for the Mandelbrot set
+	if ((bulbTest || periodicityTest) && formula.kind == FractalFormula::MANDELBROT){
+		switch (profile.blockSize){
+			case 16:  return calculateWithShortcuts<T, 16>();
+			case 32:  return calculateWithShortcuts<T, 32>();
+			case 128: return calculateWithShortcuts<T, 128>();
+			case 256: return calculateWithShortcuts<T, 256>();
+			case 512: return calculateWithShortcuts<T, 512>();
+			default:  return calculateWithShortcuts<T, 64>();
+		}
+	}
+
+	switch (formula.kind){
+		case FractalFormula::MULTIBROT3:   return dispatchBlock<T>(Formulas::Multibrot<3>());
+		case FractalFormula::MULTIBROT4:   return dispatchBlock<T>(Formulas::Multibrot<4>());
+		case FractalFormula::JULIA:        return dispatchBlock<T>(formula.juliaPolicy());
+		case FractalFormula::BURNING_SHIP: return dispatchBlock<T>(Formulas::BurningShip());
+		default:                           return dispatchBlock<T>(Formulas::Mandelbrot());
+	}
+}
+
+
+template <typename T, class Formula>
+int * BatchMandelCalculator::dispatchBlock (const Formula &f) {
+
+	// Block size has to be a compile-time constant of the kernels, so every candidate has its own instantiation
+	switch (profile.blockSize){
+		case 16:  return dispatchUnroll<T, 16>(f);
+		case 32:  return dispatchUnroll<T, 32>(f);
+		case 128: return dispatchUnroll<T, 128>(f);
+		case 256: return dispatchUnroll<T, 256>(f);
+		case 512: return dispatchUnroll<T, 512>(f);
+		default:  return dispatchUnroll<T, 64>(f);
+	}
+}
+
+
+template <typename T, int blockSize, class Formula>
+int * BatchMandelCalculator::dispatchUnroll (const Formula &f) {
+
+	switch (profile.unroll){
+		case 1:  return calculate<T, blockSize, 1>(f);
+		case 4:  return calculate<T, blockSize, 4>(f);
+		case 16: return calculate<T, blockSize, 16>(f);
+		default: return calculate<T, blockSize, 8>(f);
+	}
+}
+
+
+/**
+ * @brief One iteration of the block, returns number of the elements that escaped (or escaped earlier)
+ */
+template <typename T, class Formula>
+static inline int iterateStep(int *pblock, const T *cReal, T y, T *rBlock, T *iBlock, int count, const Formula &f) {
+
+	const T bailout = T(f.bailout());
+	int limitCnt = 0;
+
+	// Iterate elements in the block
+	#pragma omp simd reduction(+:limitCnt)
+	for (int j = 0; j < count; ++j){
+
+		T x = cReal[j]; // current real value
 
-	// Choose block size
-	const int blockSize = 64; // tried: 512, 256, 128, 64, 32, 16 (64 was the best, it is size of cache line)
+		T zReal = rBlock[j];
+		T zImag = iBlock[j];
+
+		// Calculate the condition
+		int cond = (zReal * zReal + zImag * zImag) >= bailout;
+		pblock[j] += !cond;
+		limitCnt += cond;
+
+		// Update values in buffers
+		f.step(zReal, zImag, x, y);
+		!cond && (rBlock[j] = zReal);
+		!cond && (iBlock[j] = zImag);
+	}
+	return limitCnt;
+}
+
+
+/**
+ * @brief Iterates one block until all its elements escape or the limit is reached (escape is checked in every iteration)
+ */
+template <typename T, class Formula>
+static inline void iterateBlock(int *pblock, const T *cReal, T y, T *rBlock, T *iBlock, int count, int limit, const Formula &f) {
+
+	// Initialize the block
+	#pragma omp simd
+	for (int j = 0; j < count; ++j){
+		pblock[j] = 0;
+		rBlock[j] = cReal[j];
+		iBlock[j] = y;
+	}
+
+	// Iterate limits for the block
+	for (int l = 0; l < limit; ++l){
+
+		// Stop if the block is fully computed
+		if (iterateStep(pblock, cReal, y, rBlock, iBlock, count, f) >= count) return;
+	}
+}
+
+
+template <typename T, int blockSize, int unroll, class Formula>
+int * BatchMandelCalculator::calculate (const Formula &f) {
+
+	T *rBuf = rBuffer.as<T>();
+	T *iBuf = iBuffer.as<T>();
+
+	// Real values of the block are loaded from memory, computing them from the index in the loop blocks vectorization (GCC)
+	alignas(64) T cReal[blockSize];
+	alignas(64) int escaped[blockSize]; // lanes rolled back by the grouped kernel
+
+	MANDEL_INSTR(instr.reset(blockSize);)
+
+	// Iterate rows (due to symmetricity just half of the rows, the second half will be mem-copied)
+	int first, last;
+	bool symmetric;
+	computedRows(first, last, symmetric);
+	for (int i = first; i < last; ++i){
+		int *pdata = data + width * i;
+		T y = y_start + i * dy; // current imaginary value
+		MANDEL_INSTR(const auto rowStart = MandelInstrumentation::Clock::now();)
+
+		// Iterate blocks in the row (the last block can be shorter)
+		for (int blockStart = 0; blockStart < width; blockStart += blockSize){
+
+			const int count = std::min(blockSize, width - blockStart);
+
+			#pragma omp simd
+			for (int j = 0; j < count; ++j)
+				cReal[j] = x_start + (blockStart + j) * dx;
+
+			// Escape is checked once per unroll iterations, the escaped lanes are rolled back (see MandelKernels::grouped)
+			auto iterate = [&](auto n){
+				if (unroll == 1)
+					iterateBlock(pdata + blockStart, (const T*)cReal, y, rBuf + blockStart, iBuf + blockStart, n, limit, f);
+				else
+					MandelKernels::grouped<unroll>(pdata + blockStart, (const T*)cReal, y, n, limit, rBuf + blockStart, iBuf + blockStart, escaped, f);
+			};
+
+			// Full blocks pass the block size as a type (own instance of the lambda), so the trip count of the vectorized
+			// loops is a compile-time constant even if the kernel is not inlined into the lambda
+			if (count == blockSize)
+				iterate(std::integral_constant<int, blockSize>());
+			else
+				iterate(count);
+
+			MANDEL_INSTR(instr.block(i, blockStart, pdata + blockStart, count, limit);)
+		}
+		MANDEL_INSTR(instr.row(i, rowStart);)
+		// Copy the row to next half of the image
+		if (symmetric)
+			std::memcpy(data + (height-i-1) * width, data + (i * width), width * sizeof(int));
+	}
+	return data;
+}
+
+
+template <typename T, int blockSize>
+int * BatchMandelCalculator::calculateWithShortcuts () {
 
 	// Iterate rows (due to symmetricity just half of the rows, the second half will be mem-copied)
-	for (int i = 0; i < height / 2; ++i){
+	int first, last;
+	bool symmetric;
+	computedRows(first, last, symmetric);
+	for (int i = first; i < last; ++i){
 		int *pdata = data + width * i;
-		float y = y_start + i * dy; // current imaginary value
-		
-		// Iterate blocks in the row
-		for (int blockN = 0; blockN < width / blockSize; ++blockN){
-			
-			// Iterate limits for each block
-			for (int l = 0; l < limit; ++l){
-	
-				int limitCnt = 0;
-
-				// Iterate elements in the block
-				#pragma omp simd reduction(+:limitCnt)
-				for (int j = 0; j < blockSize; ++j){
-					
-					int jGlobal = blockN * blockSize + j;
-
-					float x = x_start + jGlobal * dx; // current real value
-
-					float zReal = (l == 0) ? x : rBuffer[jGlobal];
-					float zImag = (l == 0) ? y : iBuffer[jGlobal];
-
-					// Calculate limit
-					float r2 = zReal * zReal;
-					float i2 = zImag * zImag;
-
-					// Calculate the condition
-					int cond = (r2 + i2) >= 4.0f;
-					pdata[jGlobal] += !cond;
-					limitCnt += cond;
-					
-					// Update values in buffers
-					!cond && (rBuffer[jGlobal] = (r2 - i2 + x));
-					!cond && (iBuffer[jGlobal] = (2.0f * zReal * zImag + y));
-				}
-
-				// Stop if the row is fully computed
-				if (limitCnt >= blockSize) break;
-			}
+		T y = y_start + i * dy; // current imaginary value
+
+		// Iterate blocks in the row (the last block can be shorter), every block has its part of the buffers
+		for (int blockStart = 0; blockStart < width; blockStart += blockSize){
+			const int blockEnd = std::min(blockStart + blockSize, width);
+			MandelKernels::shortcutRow(pdata, blockStart, blockEnd, x_start, dx, y, limit, bulbTest, periodicityTest,
+			                           rBuffer.as<T>() + blockStart, iBuffer.as<T>() + blockStart,
+			                           prBuffer.as<T>() + blockStart, piBuffer.as<T>() + blockStart);
 		}
 		// Copy the row to next half of the image
-		std::memcpy(data + (height-i-1) * width, data + (i * width), width * sizeof(int));
+		if (symmetric)
+			std::memcpy(data + (height-i-1) * width, data + (i * width), width * sizeof(int));
 	}
 	return data;
 }
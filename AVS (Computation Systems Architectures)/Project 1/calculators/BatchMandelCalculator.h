@@ -8,18 +8,79 @@
 #define BATCHMANDELCALCULATOR_H
 
 #include <BaseMandelCalculator.h>
+#include "ScratchBuffer.h"
+#include "BlockProfile.h"
+#include "MandelInstrumentation.h"
 
 class BatchMandelCalculator : public BaseMandelCalculator
 {
 public:
+    /**
+     * @brief Construct a new Batch Mandel Calculator object, the block size is loaded from the profile of this CPU
+     */
     BatchMandelCalculator(unsigned matrixBaseSize, unsigned limit);
     ~BatchMandelCalculator();
     int * calculateMandelbrot();
 
+    /**
+     * @brief Computes only rows [rowStart, rowEnd) of the image (e.g. a band of a distributed render), the rows are
+     * stored at their place in the returned matrix and the rest of it is not changed
+     */
+    int *calculateRows(int rowStart, int rowEnd);
+
+    /**
+     * @brief Overrides the loaded block profile (used by the autotuner), unsupported profiles are replaced by the default
+     */
+    void setBlockProfile(const BlockProfile &profile);
+
+    const BlockProfile &blockProfile() const { return profile; }
+
+#ifdef MANDEL_INSTRUMENT
+    /**
+     * @brief Statistics of the last calculation (the kernels with the interior shortcuts are not recorded)
+     */
+    const MandelInstrumentation &instrumentation() const { return instr; }
+#endif
+
 private:
+    /**
+     * @brief Selects the kernel instantiated for the formula
+     */
+    template <typename T>
+    int *dispatch();
+
+    /**
+     * @brief Selects the kernel instantiated for the block size of the profile
+     */
+    template <typename T, class Formula>
+    int *dispatchBlock(const Formula &f);
+
+    /**
+     * @brief Selects the kernel instantiated for the unroll factor of the profile
+     */
+    template <typename T, int blockSize, class Formula>
+    int *dispatchUnroll(const Formula &f);
+
+    template <typename T, int blockSize, int unroll, class Formula>
+    int *calculate(const Formula &f);
+
+    /**
+     * @brief Variant of the kernel with the interior-point shortcuts (see setInteriorShortcuts())
+     */
+    template <typename T, int blockSize>
+    int *calculateWithShortcuts();
+
+    BlockProfile profile;
+
     int *data;
-    float *rBuffer;
-    float *iBuffer;
+    ScratchBuffer rBuffer; // viewed as T* of the precision of the frame
+    ScratchBuffer iBuffer;
+    ScratchBuffer prBuffer; // saved point of the orbit for periodicity test (real)
+    ScratchBuffer piBuffer; // saved point of the orbit for periodicity test (imag)
+
+#ifdef MANDEL_INSTRUMENT
+    MandelInstrumentation instr;
+#endif
 };
 
 #endif
\ No newline at end of file
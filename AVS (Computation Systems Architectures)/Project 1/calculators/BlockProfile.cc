@@ -0,0 +1,146 @@
+/**
+ * @file BlockProfile.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Tuned block size and unroll factor of the batch kernels, stored per CPU model in a profile file
+ * @date 17.10.2026
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <stdlib.h>
+
+#include "BlockProfile.h"
+
+static const char *SYSFS_CACHE_DIR = "/sys/devices/system/cpu/cpu0/cache/index";
+
+
+const std::vector<int> &BlockProfile::blockSizes()
+{
+	static const std::vector<int> sizes = {16, 32, 64, 128, 256, 512};
+	return sizes;
+}
+
+const std::vector<int> &BlockProfile::unrolls()
+{
+	static const std::vector<int> factors = {1, 4, 8, 16};
+	return factors;
+}
+
+bool BlockProfile::isSupported() const
+{
+	return std::count(blockSizes().begin(), blockSizes().end(), blockSize) &&
+		std::count(unrolls().begin(), unrolls().end(), unroll);
+}
+
+
+std::string BlockProfile::path()
+{
+	if (const char *file = getenv("MANDEL_PROFILE"))
+		return file;
+	if (const char *home = getenv("HOME"))
+		return std::string(home) + "/.mandel_profiles";
+	return "";
+}
+
+std::string BlockProfile::cpuModel()
+{
+	std::ifstream in("/proc/cpuinfo");
+	std::string line;
+	while (std::getline(in, line)){
+		if (line.rfind("model name", 0) == 0){
+			std::string model = line.substr(line.find(':') + 1);
+			model.erase(0, model.find_first_not_of(" \t"));
+			// ';' separates the columns of the profile file
+			std::replace(model.begin(), model.end(), ';', ',');
+			return model;
+		}
+	}
+	return "unknown";
+}
+
+std::vector<CacheLevel> BlockProfile::caches()
+{
+	std::vector<CacheLevel> levels;
+	for (int index = 0; ; ++index){
+		const std::string dir = SYSFS_CACHE_DIR + std::to_string(index) + "/";
+		std::ifstream level(dir + "level"), type(dir + "type"), size(dir + "size"), line(dir + "coherency_line_size");
+		if (!level) break;
+
+		CacheLevel cache = {0, "", 0, 0};
+		std::string sizeStr;
+		level >> cache.level;
+		type >> cache.type;
+		size >> sizeStr;
+		line >> cache.lineSize;
+
+		// Size is given as e.g. "48K" or "32M"
+		if (!sizeStr.empty()){
+			cache.size = std::stol(sizeStr);
+			const char unit = sizeStr.back();
+			if (unit == 'K') cache.size *= 1024;
+			if (unit == 'M') cache.size *= 1024 * 1024;
+		}
+		levels.push_back(cache);
+	}
+	return levels;
+}
+
+
+BlockProfile BlockProfile::load()
+{
+	BlockProfile profile;
+	const std::string file = path();
+	if (file.empty()) return profile;
+
+	std::ifstream in(file);
+	const std::string model = cpuModel();
+	std::string line;
+	while (std::getline(in, line)){
+		std::stringstream ss(line);
+		std::string lineModel, blockSize, unroll;
+		if (!std::getline(ss, lineModel, ';') || lineModel != model) continue;
+		if (!std::getline(ss, blockSize, ';') || !std::getline(ss, unroll, ';')) continue;
+
+		BlockProfile stored;
+		try {
+			stored.blockSize = std::stoi(blockSize);
+			stored.unroll = std::stoi(unroll);
+		} catch (const std::exception &) {
+			continue;
+		}
+
+		// Profile written by a build with other candidates is ignored
+		if (stored.isSupported())
+			profile = stored;
+	}
+	return profile;
+}
+
+bool BlockProfile::store(const BlockProfile &profile)
+{
+	const std::string file = path();
+	if (file.empty()) return false;
+
+	// Profiles of the other CPUs are kept
+	const std::string model = cpuModel();
+	std::vector<std::string> lines;
+	{
+		std::ifstream in(file);
+		std::string line;
+		while (std::getline(in, line)){
+			if (!line.empty() && line.substr(0, line.find(';')) != model)
+				lines.push_back(line);
+		}
+	}
+	lines.push_back(model + ";" + std::to_string(profile.blockSize) + ";" + std::to_string(profile.unroll));
+
+	std::ofstream out(file, std::ios::trunc);
+	for (const std::string &line : lines)
+		out << line << std::endl;
+	return bool(out);
+}
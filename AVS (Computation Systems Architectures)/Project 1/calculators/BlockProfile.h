@@ -0,0 +1,71 @@
+/**
+ * @file BlockProfile.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Tuned block size and unroll factor of the batch kernels, stored per CPU model in a profile file
+ * @date 17.10.2026
+ */
+#ifndef BLOCKPROFILE_H
+#define BLOCKPROFILE_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Cache of the CPU read from sysfs (/sys/devices/system/cpu/cpu0/cache)
+ */
+struct CacheLevel
+{
+    int level;
+    std::string type; // Data, Instruction, Unified
+    long size;        // bytes
+    int lineSize;     // bytes
+};
+
+/**
+ * @brief Parameters of the batch kernels (see BatchMandelCalculator)
+ *
+ * Profiles are stored as lines "cpu model;block size;unroll" in the file given by MANDEL_PROFILE environment
+ * variable, or ~/.mandel_profiles. The kernels are instantiated only for the candidate values below.
+ */
+struct BlockProfile
+{
+    int blockSize = 64; // elements computed together (64 was the best by manual trial)
+    int unroll = 8;     // iterations between escape checks (1 = every iteration, more = MandelKernels::grouped)
+
+    static const std::vector<int> &blockSizes(); // candidate block sizes
+    static const std::vector<int> &unrolls();    // candidate unroll factors
+
+    /**
+     * @brief True if the kernels are instantiated for the profile
+     */
+    bool isSupported() const;
+
+    /**
+     * @brief Profile of this CPU from the profile file, the default profile if there is none
+     */
+    static BlockProfile load();
+
+    /**
+     * @brief Stores the profile of this CPU into the profile file (replaces the previous one)
+     *
+     * @return false if the file can not be written
+     */
+    static bool store(const BlockProfile &profile);
+
+    /**
+     * @brief Path of the profile file (empty if it can not be determined)
+     */
+    static std::string path();
+
+    /**
+     * @brief Model name of the CPU (from /proc/cpuinfo)
+     */
+    static std::string cpuModel();
+
+    /**
+     * @brief Cache hierarchy of the CPU (empty if sysfs is not available)
+     */
+    static std::vector<CacheLevel> caches();
+};
+
+#endif
@@ -0,0 +1,142 @@
+/**
+ * @file CompactMandelCalculator.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator that stores iteration counts as uint8_t / uint16_t (optionally half of the image)
+ * @date 17.10.2026
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+
+#include <stdlib.h>
+
+#include <immintrin.h>	// _mm_malloc()
+#include <cstring>	    // memcpy()
+
+#include "MandelKernels.h"
+#include "CompactMandelCalculator.h"
+
+
+CompactMandelCalculator::CompactMandelCalculator (unsigned matrixBaseSize, unsigned limit, bool halfImage) :
+	BaseMandelCalculator(matrixBaseSize, limit, "CompactMandelCalculator"), halfImage(halfImage),
+	outFormat(limit <= UINT8_MAX ? Format::U8 : Format::U16), storedRows(0), allocatedRows(0), compactData(nullptr),
+	data(nullptr)
+{
+	formulasSupported = true;
+	if (limit > UINT16_MAX)
+		throw std::invalid_argument("CompactMandelCalculator: limit " + std::to_string(limit) + " does not fit into uint16_t");
+
+	cVariant = (outFormat == Format::U8) ? "u8" : "u16";
+	if (halfImage) cVariant += ",half";
+}
+
+CompactMandelCalculator::~CompactMandelCalculator() {
+	_mm_free(compactData);
+	_mm_free(data);
+	compactData = nullptr;
+	data = nullptr;
+}
+
+
+template <typename T, typename Out>
+void CompactMandelCalculator::dispatch (Out *out, int rows) {
+
+	switch (formula.kind){
+		case FractalFormula::MULTIBROT3:   return calculate<T>(out, rows, Formulas::Multibrot<3>());
+		case FractalFormula::MULTIBROT4:   return calculate<T>(out, rows, Formulas::Multibrot<4>());
+		case FractalFormula::JULIA:        return calculate<T>(out, rows, formula.juliaPolicy());
+		case FractalFormula::BURNING_SHIP: return calculate<T>(out, rows, Formulas::BurningShip());
+		default:                           return calculate<T>(out, rows, Formulas::Mandelbrot());
+	}
+}
+
+
+template <typename T, typename Out, class Formula>
+void CompactMandelCalculator::calculate (Out *out, int rows, const Formula &f) {
+
+	// Rows are independent, scratch buffers are on the stack of each thread
+	#pragma omp parallel for schedule(dynamic, 1)
+	for (int i = 0; i < rows; ++i){
+		alignas(64) T rBuffer[MandelKernels::blockSize];
+		alignas(64) T iBuffer[MandelKernels::blockSize];
+
+		T y = y_start + i * dy; // current imaginary value
+		MandelKernels::row(out + width * i, 0, width, x_start, dx, y, limit, rBuffer, iBuffer, f);
+	}
+
+	// Copy the rows to next half of the image (only if the bottom half is stored)
+	if (rows < storedRows){
+		for (int i = 0; i < rows; ++i)
+			std::memcpy(out + (height-i-1) * width, out + (i * width), width * sizeof(Out));
+	}
+}
+
+
+void CompactMandelCalculator::calculateCompact () {
+
+	// Due to symmetricity just half of the rows is computed, the bottom half is mirrored only if it is stored
+	const bool symmetric = isSymmetric();
+	const int rows = symmetric ? height / 2 : height;
+	storedRows = (symmetric && halfImage) ? rows : height;
+
+	// Storage follows the rows of the frame (the viewport and the formula decide the symmetry), it only grows
+	if (storedRows > allocatedRows){
+		const size_t elemSize = (outFormat == Format::U8) ? sizeof(uint8_t) : sizeof(uint16_t);
+		_mm_free(compactData);
+		compactData = _mm_malloc(storedRows * width * elemSize, 64);
+		allocatedRows = storedRows;
+	}
+
+	const bool doublePrecision = needsDoublePrecision();
+	if (outFormat == Format::U8){
+		uint8_t *out = (uint8_t*)compactData;
+		doublePrecision ? dispatch<double>(out, rows) : dispatch<float>(out, rows);
+	} else {
+		uint16_t *out = (uint16_t*)compactData;
+		doublePrecision ? dispatch<double>(out, rows) : dispatch<float>(out, rows);
+	}
+}
+
+
+template <typename Out>
+MandelImageView<Out> CompactMandelCalculator::view () const {
+
+	const Format requested = (sizeof(Out) == sizeof(uint8_t)) ? Format::U8 : Format::U16;
+	if (requested != outFormat)
+		throw std::logic_error("CompactMandelCalculator: view type does not match the output format");
+
+	return MandelImageView<Out>{(const Out*)compactData, width, height, storedRows};
+}
+
+template MandelImageView<uint8_t> CompactMandelCalculator::view<uint8_t>() const;
+template MandelImageView<uint16_t> CompactMandelCalculator::view<uint16_t>() const;
+
+
+int * CompactMandelCalculator::calculateMandelbrot () {
+
+	calculateCompact();
+
+	// The widened image is needed only by the common interface, so it is not allocated in the constructor
+	if (!data)
+		data = (int*)(_mm_malloc(height * width * sizeof(int), 64));
+
+	for (int i = 0; i < height; ++i){
+		int *pdata = data + width * i;
+		if (outFormat == Format::U8){
+			const uint8_t *prow = view<uint8_t>().row(i);
+			#pragma omp simd
+			for (int j = 0; j < width; ++j)
+				pdata[j] = prow[j];
+		} else {
+			const uint16_t *prow = view<uint16_t>().row(i);
+			#pragma omp simd
+			for (int j = 0; j < width; ++j)
+				pdata[j] = prow[j];
+		}
+	}
+	return data;
+}
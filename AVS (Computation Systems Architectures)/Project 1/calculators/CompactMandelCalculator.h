@@ -0,0 +1,77 @@
+/**
+ * @file CompactMandelCalculator.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator that stores iteration counts as uint8_t / uint16_t (optionally half of the image)
+ * @date 17.10.2026
+ */
+#ifndef COMPACTMANDELCALCULATOR_H
+#define COMPACTMANDELCALCULATOR_H
+
+#include <cstdint>
+
+#include <BaseMandelCalculator.h>
+#include "MandelImage.h"
+
+class CompactMandelCalculator : public BaseMandelCalculator
+{
+public:
+    /**
+     * @brief Type of the stored iteration counts
+     */
+    enum class Format { U8, U16 };
+
+    /**
+     * @brief Construct a new Compact Mandel Calculator object
+     *
+     * @param matrixBaseSize basic size (width will be multiplied by 3, height by 2)
+     * @param limit number of iterations (at most 65535, uint8_t is used if it is at most 255)
+     * @param halfImage true = the mirrored bottom half of a symmetric viewport is neither stored nor allocated (see
+     * MandelImageView)
+     */
+    CompactMandelCalculator(unsigned matrixBaseSize, unsigned limit, bool halfImage = true);
+    ~CompactMandelCalculator();
+
+    /**
+     * @brief Computes the compact image and widens it to int (for callers of the common interface)
+     */
+    int *calculateMandelbrot();
+
+    /**
+     * @brief Computes the compact image without widening it, the result is read by view()
+     */
+    void calculateCompact();
+
+    /**
+     * @brief Type of the stored iteration counts
+     */
+    Format format() const { return outFormat; }
+
+    /**
+     * @brief View of the last computed image, Out has to match format() (uint8_t / uint16_t)
+     */
+    template <typename Out>
+    MandelImageView<Out> view() const;
+
+private:
+    /**
+     * @brief Selects the kernel instantiated for the formula
+     */
+    template <typename T, typename Out>
+    void dispatch(Out *out, int rows);
+
+    /**
+     * @brief Computes the first rows of the image into out and mirrors them if the bottom half is stored
+     */
+    template <typename T, typename Out, class Formula>
+    void calculate(Out *out, int rows, const Formula &f);
+
+    const bool halfImage;
+    const Format outFormat;
+    int storedRows; // rows stored by the last calculation (height / 2 for half image)
+    int allocatedRows; // rows of compactData
+
+    void *compactData; // uint8_t or uint16_t, allocatedRows * width elements
+    int *data;         // widened image, allocated by the first calculateMandelbrot()
+};
+
+#endif
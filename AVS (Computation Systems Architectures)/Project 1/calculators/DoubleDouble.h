@@ -0,0 +1,139 @@
+/**
+ * @file DoubleDouble.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Double-double arithmetic (unevaluated sum of two doubles, ~106 bit mantissa) for high-precision reference orbits
+ * @date 17.10.2026
+ */
+#ifndef DOUBLEDOUBLE_H
+#define DOUBLEDOUBLE_H
+
+#include <cmath>
+#include <string>
+#include <cctype>
+#include <stdexcept>
+
+/**
+ * @brief Number represented as hi + lo, where |lo| <= ulp(hi) / 2
+ *
+ * The error-free transformations rely on IEEE rounding, the code must not be compiled with -ffast-math.
+ */
+struct DoubleDouble
+{
+    double hi;
+    double lo;
+
+    DoubleDouble(double hi = 0.0, double lo = 0.0) : hi(hi), lo(lo) {}
+
+    /**
+     * @brief Parses decimal number (e.g. "-0.7436438870371587047", "1.5e-3") with full double-double precision
+     */
+    static DoubleDouble fromString(const std::string &str);
+};
+
+// s + e = a + b exactly
+static inline DoubleDouble ddTwoSum(double a, double b)
+{
+    double s = a + b;
+    double bb = s - a;
+    double e = (a - (s - bb)) + (b - bb);
+    return DoubleDouble(s, e);
+}
+
+// s + e = a + b exactly, requires |a| >= |b|
+static inline DoubleDouble ddQuickTwoSum(double a, double b)
+{
+    double s = a + b;
+    double e = b - (s - a);
+    return DoubleDouble(s, e);
+}
+
+static inline DoubleDouble operator+(const DoubleDouble &a, const DoubleDouble &b)
+{
+    DoubleDouble s = ddTwoSum(a.hi, b.hi);
+    DoubleDouble t = ddTwoSum(a.lo, b.lo);
+    s.lo += t.hi;
+    s = ddQuickTwoSum(s.hi, s.lo);
+    s.lo += t.lo;
+    return ddQuickTwoSum(s.hi, s.lo);
+}
+
+static inline DoubleDouble operator-(const DoubleDouble &a)
+{
+    return DoubleDouble(-a.hi, -a.lo);
+}
+
+static inline DoubleDouble operator-(const DoubleDouble &a, const DoubleDouble &b)
+{
+    return a + (-b);
+}
+
+static inline DoubleDouble operator*(const DoubleDouble &a, const DoubleDouble &b)
+{
+    double p = a.hi * b.hi;
+    double e = std::fma(a.hi, b.hi, -p);
+    e += a.hi * b.lo + a.lo * b.hi;
+    return ddQuickTwoSum(p, e);
+}
+
+static inline DoubleDouble operator/(const DoubleDouble &a, const DoubleDouble &b)
+{
+    double q1 = a.hi / b.hi;
+    DoubleDouble r = a - b * DoubleDouble(q1);
+    double q2 = r.hi / b.hi;
+    r = r - b * DoubleDouble(q2);
+    double q3 = r.hi / b.hi;
+    return ddQuickTwoSum(q1, q2) + DoubleDouble(q3);
+}
+
+inline DoubleDouble DoubleDouble::fromString(const std::string &str)
+{
+    size_t pos = 0;
+    while (pos < str.size() && std::isspace((unsigned char)str[pos])) ++pos;
+
+    bool negative = false;
+    if (pos < str.size() && (str[pos] == '-' || str[pos] == '+'))
+        negative = str[pos++] == '-';
+
+    // Digits are accumulated as an integer, the decimal point only shifts the exponent
+    DoubleDouble value;
+    int exponent = 0;
+    bool digits = false;
+    bool fraction = false;
+    for (; pos < str.size(); ++pos)
+    {
+        char c = str[pos];
+        if (std::isdigit((unsigned char)c))
+        {
+            value = value * DoubleDouble(10.0) + DoubleDouble(c - '0');
+            if (fraction) --exponent;
+            digits = true;
+        }
+        else if (c == '.' && !fraction)
+        {
+            fraction = true;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if (pos < str.size() && (str[pos] == 'e' || str[pos] == 'E'))
+    {
+        size_t consumed = 0;
+        exponent += std::stoi(str.substr(pos + 1), &consumed);
+        pos += 1 + consumed;
+    }
+
+    if (!digits || pos != str.size())
+        throw std::invalid_argument("DoubleDouble: invalid number '" + str + "'");
+
+    DoubleDouble scale(1.0);
+    for (int i = 0; i < std::abs(exponent); ++i)
+        scale = scale * DoubleDouble(10.0);
+    value = exponent < 0 ? value / scale : value * scale;
+
+    return negative ? -value : value;
+}
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @file Formulas.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Escape-time formulas, used as compile-time policies of the vectorized kernels
+ * @date 17.10.2026
+ */
+#ifndef FORMULAS_H
+#define FORMULAS_H
+
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Every formula iterates z from z0 = pixel and provides:
+ *
+ *   void step(T &zReal, T &zImag, T x, T y) const   one iteration, (x, y) is the pixel
+ *   double bailout() const                         |z|^2 at which the point escaped
+ *
+ * Once |z|^2 reaches the bailout, |z| never decreases again (MandelKernels::grouped relies on it).
+ *
+ * The calculators evaluate step() scalar, vectorized and unrolled (MandelKernels::grouped), so their results are
+ * bit-identical only if the products are never contracted into FMAs (the compiler would fuse them differently in each
+ * context). FpContract.h switches the contraction off in the code of the kernels, whatever the build flags are.
+ */
+namespace Formulas
+{
+
+/**
+ * @brief z = z^2 + pixel (the operations are in the same order as in the reference calculator)
+ */
+struct Mandelbrot
+{
+    template <typename T>
+    inline void step(T &zReal, T &zImag, T x, T y) const
+    {
+        T r2 = zReal * zReal;
+        T i2 = zImag * zImag;
+        zImag = T(2.0) * zReal * zImag + y;
+        zReal = r2 - i2 + x;
+    }
+
+    double bailout() const { return 4.0; }
+};
+
+/**
+ * @brief z = z^power + pixel
+ */
+template <int power>
+struct Multibrot
+{
+    template <typename T>
+    inline void step(T &zReal, T &zImag, T x, T y) const
+    {
+        T pReal = zReal;
+        T pImag = zImag;
+        #pragma GCC unroll 8
+        for (int k = 1; k < power; ++k)
+        {
+            T tmp = pReal * zReal - pImag * zImag;
+            pImag = pReal * zImag + pImag * zReal;
+            pReal = tmp;
+        }
+        zReal = pReal + x;
+        zImag = pImag + y;
+    }
+
+    double bailout() const { return 4.0; }
+};
+
+/**
+ * @brief z = z^2 + c with constant c, the pixel is only the starting point
+ */
+struct Julia
+{
+    double cReal;
+    double cImag;
+
+    template <typename T>
+    inline void step(T &zReal, T &zImag, T, T) const
+    {
+        T r2 = zReal * zReal;
+        T i2 = zImag * zImag;
+        zImag = T(2.0) * zReal * zImag + T(cImag);
+        zReal = r2 - i2 + T(cReal);
+    }
+
+    // Radius 2 is not enough for |c| > 2 (|z| could decrease after reaching it)
+    double bailout() const { return std::max(4.0, cReal * cReal + cImag * cImag); }
+};
+
+/**
+ * @brief z = (|Re z| + i |Im z|)^2 + pixel
+ */
+struct BurningShip
+{
+    template <typename T>
+    inline void step(T &zReal, T &zImag, T x, T y) const
+    {
+        T a = std::abs(zReal);
+        T b = std::abs(zImag);
+        zImag = T(2.0) * a * b + y;
+        zReal = a * a - b * b + x;
+    }
+
+    double bailout() const { return 4.0; }
+};
+
+} // namespace Formulas
+
+
+/**
+ * @brief Formula selected at runtime (see BaseMandelCalculator::setFormula()), the calculators dispatch it to the
+ * policies above once per frame
+ */
+struct FractalFormula
+{
+    enum Kind { MANDELBROT, MULTIBROT3, MULTIBROT4, JULIA, BURNING_SHIP };
+
+    Kind kind = MANDELBROT;
+    double juliaReal = 0.0; // constant c of the Julia set
+    double juliaImag = 0.0;
+
+    static FractalFormula mandelbrot() { return FractalFormula(); }
+    static FractalFormula multibrot(int power)
+    {
+        // Kernels are instantiated only for these powers (power 2 is the Mandelbrot set)
+        if (power < 2 || power > 4)
+            throw std::invalid_argument("FractalFormula: unsupported multibrot power " + std::to_string(power));
+
+        FractalFormula f;
+        f.kind = (power == 2) ? MANDELBROT : (power == 3) ? MULTIBROT3 : MULTIBROT4;
+        return f;
+    }
+    static FractalFormula julia(double cReal, double cImag)
+    {
+        FractalFormula f;
+        f.kind = JULIA;
+        f.juliaReal = cReal;
+        f.juliaImag = cImag;
+        return f;
+    }
+    static FractalFormula burningShip()
+    {
+        FractalFormula f;
+        f.kind = BURNING_SHIP;
+        return f;
+    }
+
+    Formulas::Julia juliaPolicy() const { return Formulas::Julia{juliaReal, juliaImag}; }
+
+    /**
+     * @brief True if the conjugated pixel has the same value (rows mirrored about the real axis are the same)
+     */
+    bool conjugateSymmetric() const
+    {
+        return kind == MANDELBROT || kind == MULTIBROT3 || kind == MULTIBROT4 || (kind == JULIA && juliaImag == 0.0);
+    }
+
+    std::string name() const
+    {
+        switch (kind)
+        {
+        case MULTIBROT3:   return "multibrot3";
+        case MULTIBROT4:   return "multibrot4";
+        case JULIA:        return "julia";
+        case BURNING_SHIP: return "burningship";
+        default:           return "mandelbrot";
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,24 @@
+/**
+ * @file FpContract.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Switches off contraction of floating point multiply-add into FMA for the rest of the translation unit
+ * @date 17.10.2026
+ *
+ * GCC contracts a * b + c into an FMA by default (-ffp-contract=fast) wherever it sees fit, so the same formula step
+ * rounds differently in the scalar, vectorized and unrolled kernels (see Formulas.h). The pragma gives every
+ * function defined after it -ffp-contract=off, whatever the build flags are. GCC ignores #pragma STDC FP_CONTRACT.
+ *
+ * Included by MandelKernels.h, the translation units that iterate the formulas without the shared kernels include
+ * it themselves. Functions defined before the include keep the flags of the build, they may still be inlined into
+ * the kernels, which are compiled without contraction.
+ */
+#ifndef FPCONTRACT_H
+#define FPCONTRACT_H
+
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#endif
@@ -0,0 +1,170 @@
+/**
+ * @file FrameSequenceRenderer.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of renderer of zoom / pan animations that keeps its buffers across frames and reuses panned regions
+ * @date 17.10.2026
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <future>
+#include <cmath>
+
+#include <stdlib.h>
+
+#include <immintrin.h>	// _mm_malloc()
+#include <cstring>	    // memcpy()
+#include <omp.h>
+
+#include "MandelKernels.h"
+#include "FrameSequenceRenderer.h"
+
+// Largest distance of the pan from whole pixels (in pixels) for which the previous frame is reused
+static const double PAN_PIXEL_TOLERANCE = 1e-3;
+
+
+FrameSequenceRenderer::FrameSequenceRenderer (unsigned matrixBaseSize, unsigned limit) :
+	BaseMandelCalculator(matrixBaseSize, limit, "FrameSequenceRenderer"), current(0), hasPrevious(false), lastReused(0)
+{
+	formulasSupported = true;
+	buffers[0] = (int*)(_mm_malloc(height * width * sizeof(int), 64));
+	buffers[1] = (int*)(_mm_malloc(height * width * sizeof(int), 64));
+
+	threads = omp_get_max_threads();
+	for (int t = 0; t < threads; ++t){
+		rBuffers.emplace_back(MandelKernels::blockSize);
+		iBuffers.emplace_back(MandelKernels::blockSize);
+	}
+}
+
+FrameSequenceRenderer::~FrameSequenceRenderer() {
+	_mm_free(buffers[0]);
+	_mm_free(buffers[1]);
+	buffers[0] = nullptr;
+	buffers[1] = nullptr;
+}
+
+
+bool FrameSequenceRenderer::panOffset(int &shiftX, int &shiftY) const {
+
+	if (!hasPrevious || prevDouble != needsDoublePrecision()) return false;
+
+	if (formula.kind != prevFormula.kind || formula.juliaReal != prevFormula.juliaReal || formula.juliaImag != prevFormula.juliaImag)
+		return false;
+
+	// Zoom changes the pixel spacing, nothing can be reused
+	if (std::abs(dx - prevDx) > prevDx * 1e-9 || std::abs(dy - prevDy) > prevDy * 1e-9) return false;
+
+	const double sx = (x_start - prevXStart) / dx;
+	const double sy = (y_start - prevYStart) / dy;
+	if (std::abs(sx) >= width || std::abs(sy) >= height) return false;
+	if (std::abs(sx - std::round(sx)) > PAN_PIXEL_TOLERANCE || std::abs(sy - std::round(sy)) > PAN_PIXEL_TOLERANCE) return false;
+
+	shiftX = int(std::lround(sx));
+	shiftY = int(std::lround(sy));
+	return true;
+}
+
+
+int * FrameSequenceRenderer::calculateMandelbrot () {
+
+	// Float kernels are used while the pixel spacing allows it
+	int *data = needsDoublePrecision() ? dispatch<double>() : dispatch<float>();
+
+	hasPrevious = true;
+	prevXStart = x_start;
+	prevYStart = y_start;
+	prevDx = dx;
+	prevDy = dy;
+	prevDouble = needsDoublePrecision();
+	prevFormula = formula;
+	return data;
+}
+
+
+template <typename T>
+int * FrameSequenceRenderer::dispatch () {
+
+	switch (formula.kind){
+		case FractalFormula::MULTIBROT3:   return calculate<T>(Formulas::Multibrot<3>());
+		case FractalFormula::MULTIBROT4:   return calculate<T>(Formulas::Multibrot<4>());
+		case FractalFormula::JULIA:        return calculate<T>(formula.juliaPolicy());
+		case FractalFormula::BURNING_SHIP: return calculate<T>(Formulas::BurningShip());
+		default:                           return calculate<T>(Formulas::Mandelbrot());
+	}
+}
+
+
+template <typename T, class Formula>
+int * FrameSequenceRenderer::calculate (const Formula &f) {
+
+	int shiftX = 0;
+	int shiftY = 0;
+	const bool reuse = panOffset(shiftX, shiftY);
+
+	const int *prev = buffers[current];
+	int *data = buffers[current ^ 1];
+
+	// Rows are mirrored only when the whole frame is computed (reused rows are not symmetric in general)
+	const bool symmetric = !reuse && isSymmetric();
+	const int rows = symmetric ? height / 2 : height;
+
+	// Columns of a row that are still in view
+	const int copyStart = std::max(0, -shiftX);
+	const int copyEnd = std::min(width, width - shiftX);
+
+	long reused = 0;
+
+	#pragma omp parallel num_threads(threads) reduction(+:reused)
+	{
+		T *rBuffer = rBuffers[omp_get_thread_num()].as<T>();
+		T *iBuffer = iBuffers[omp_get_thread_num()].as<T>();
+
+		#pragma omp for schedule(dynamic, 8)
+		for (int i = 0; i < rows; i++){
+			int *pdata = data + i * width;
+			const T y = y_start + i * dy;
+			const int src = i + shiftY;
+
+			if (reuse && src >= 0 && src < height){
+				std::memcpy(pdata + copyStart, prev + src * width + copyStart + shiftX, (copyEnd - copyStart) * sizeof(int));
+				MandelKernels::row(pdata, 0, copyStart, x_start, dx, y, limit, rBuffer, iBuffer, f);
+				MandelKernels::row(pdata, copyEnd, width, x_start, dx, y, limit, rBuffer, iBuffer, f);
+				reused += copyEnd - copyStart;
+			}
+			else
+				MandelKernels::row(pdata, 0, width, x_start, dx, y, limit, rBuffer, iBuffer, f);
+
+			// Copy the row to next half of the image
+			if (symmetric)
+				std::memcpy(data + (height-i-1) * width, pdata, width * sizeof(int));
+		}
+	}
+
+	lastReused = reused;
+	current ^= 1;
+	return data;
+}
+
+
+void FrameSequenceRenderer::renderSequence(const std::vector<FrameViewport> &frames, const FrameEncoder &encoder) {
+
+	std::future<void> encoding;
+
+	for (int n = 0; n < (int)frames.size(); ++n){
+		const FrameViewport &v = frames[n];
+		setViewport(v.centerReal, v.centerImag, v.scale, v.aspectRatio);
+
+		// Computed while the previous frame is encoded (they are in different buffers)
+		const int *frame = calculateMandelbrot();
+
+		// The next frame overwrites the buffer of the previous one, so its encoding has to finish
+		if (encoding.valid()) encoding.get();
+
+		encoding = std::async(std::launch::async, [this, &encoder, frame, n]{ encoder(n, frame, width, height); });
+	}
+
+	if (encoding.valid()) encoding.get();
+}
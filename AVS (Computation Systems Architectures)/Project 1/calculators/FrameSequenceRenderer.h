@@ -0,0 +1,101 @@
+/**
+ * @file FrameSequenceRenderer.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Renderer of zoom / pan animations that keeps its buffers across frames and reuses panned regions
+ * @date 17.10.2026
+ */
+#ifndef FRAMESEQUENCERENDERER_H
+#define FRAMESEQUENCERENDERER_H
+
+#include <vector>
+#include <functional>
+
+#include <BaseMandelCalculator.h>
+#include "ScratchBuffer.h"
+
+/**
+ * @brief Viewport of one frame (see BaseMandelCalculator::setViewport())
+ */
+struct FrameViewport
+{
+    double centerReal;
+    double centerImag;
+    double scale;
+    double aspectRatio = 1.0;
+};
+
+class FrameSequenceRenderer : public BaseMandelCalculator
+{
+public:
+    /**
+     * @brief Called with every rendered frame, data stays valid until the next frame is finished
+     */
+    using FrameEncoder = std::function<void(int frame, const int *data, int width, int height)>;
+
+    /**
+     * @brief Construct a new Frame Sequence Renderer object
+     *
+     * @param matrixBaseSize basic size (width will be multiplied by 3, height by 2)
+     * @param limit number of iterations
+     */
+    FrameSequenceRenderer(unsigned matrixBaseSize, unsigned limit);
+    ~FrameSequenceRenderer();
+
+    /**
+     * @brief Renders the current viewport into the buffer not holding the previous frame
+     *
+     * If the viewport is the previous one moved by whole pixels (same spacing, formula and precision), the pixels
+     * still in view are copied from the previous frame and only the exposed strips are computed. Copied pixels may
+     * differ from a fresh render by the rounding of their coordinates (they were computed relative to the old origin).
+     */
+    int *calculateMandelbrot();
+
+    /**
+     * @brief Renders the frames and passes them to the encoder, encoding of a frame runs in a separate thread
+     * while the next frame is computed (the encoder is never called concurrently)
+     */
+    void renderSequence(const std::vector<FrameViewport> &frames, const FrameEncoder &encoder);
+
+    /**
+     * @brief Forgets the previous frame, the next frame is computed whole
+     */
+    void invalidate() { hasPrevious = false; }
+
+    /**
+     * @brief Number of pixels of the last frame copied from the previous one
+     */
+    long reusedPixels() const { return lastReused; }
+
+private:
+    template <typename T>
+    int *dispatch();
+
+    template <typename T, class Formula>
+    int *calculate(const Formula &f);
+
+    /**
+     * @brief True if the current viewport is the previous one moved by whole pixels (new pixel (i, j) is the old
+     * pixel (i + shiftY, j + shiftX))
+     */
+    bool panOffset(int &shiftX, int &shiftY) const;
+
+    int *buffers[2]; // frames are rendered alternately, one may be encoded while the other is computed
+    int current;     // buffer of the last frame
+
+    // Previous frame
+    bool hasPrevious;
+    double prevXStart;
+    double prevYStart;
+    double prevDx;
+    double prevDy;
+    bool prevDouble;
+    FractalFormula prevFormula;
+    long lastReused;
+
+    int threads;
+    // Per-thread scratch buffers of the row kernel (MandelKernels::blockSize elements, allocated for double)
+    std::vector<ScratchBuffer> rBuffers;
+    std::vector<ScratchBuffer> iBuffers;
+};
+
+#endif
@@ -15,70 +15,116 @@
 #include <immintrin.h>	// _mm_malloc()
 #include <cstring>	    // memcpy()
 
+#include "MandelKernels.h"
 #include "LineMandelCalculator.h"
 
 
 LineMandelCalculator::LineMandelCalculator (unsigned matrixBaseSize, unsigned limit) :
 	BaseMandelCalculator(matrixBaseSize, limit, "LineMandelCalculator")
 {
+	shortcutsSupported = true;
+	formulasSupported = true;
 	data = (int*)(_mm_malloc(height * width * sizeof(int), 64));
-	rBuffer = (float*)(_mm_malloc(width * sizeof(float), 64));
-	iBuffer = (float*)(_mm_malloc(width * sizeof(float), 64));
+	// Buffers are large enough for the double precision kernels
+	rBuffer = ScratchBuffer(width);
+	iBuffer = ScratchBuffer(width);
+	prBuffer = ScratchBuffer(width);
+	piBuffer = ScratchBuffer(width);
+	xBuffer = ScratchBuffer(width);
+	escapedBuffer = (int*)(_mm_malloc(width * sizeof(int), 64));
 }
 
 LineMandelCalculator::~LineMandelCalculator() {
 	_mm_free(data);
-	_mm_free(rBuffer);
-	_mm_free(iBuffer);
+	_mm_free(escapedBuffer);
 	data = nullptr;
-	rBuffer = nullptr;
-	iBuffer = nullptr;
+	escapedBuffer = nullptr;
 }
 
 
 int * LineMandelCalculator::calculateMandelbrot () {
 
-	// initialize data (there can also be loop over the data with #pragma omp simd, but the efficiency is the same)
-	std::memset(data, 0, height * width * sizeof(int));
+	// Shortcuts are valid only for the Mandelbrot set
+	const bool shortcuts = (bulbTest || periodicityTest) && formula.kind == FractalFormula::MANDELBROT;
+
+	// Float kernels are used while the pixel spacing allows it
+	if (needsDoublePrecision())
+		return shortcuts ? calculateWithShortcuts<double>() : dispatch<double>();
+
+	return shortcuts ? calculateWithShortcuts<float>() : dispatch<float>();
+}
+
+
+template <typename T>
+int * LineMandelCalculator::dispatch () {
+
+	switch (formula.kind){
+		case FractalFormula::MULTIBROT3:   return calculate<T>(Formulas::Multibrot<3>());
+		case FractalFormula::MULTIBROT4:   return calculate<T>(Formulas::Multibrot<4>());
+		case FractalFormula::JULIA:        return calculate<T>(formula.juliaPolicy());
+		case FractalFormula::BURNING_SHIP: return calculate<T>(Formulas::BurningShip());
+		default:                           return calculate<T>(Formulas::Mandelbrot());
+	}
+}
+
+
+template <typename T, class Formula>
+int * LineMandelCalculator::calculate (const Formula &f) {
+
+	T *rBuf = rBuffer.as<T>();
+	T *iBuf = iBuffer.as<T>();
+	T *xBuf = xBuffer.as<T>();
+
+	// Real values are the same for all rows
+	#pragma omp simd
+	for (int j = 0; j < width; ++j)
+		xBuf[j] = x_start + j * dx;
+
+	MANDEL_INSTR(instr.reset(width);)
 
 	// Iterate rows (due to symmetricity just half of the rows, the second half will be mem-copied)
-	for (int i = 0; i < height / 2; ++i){
+	const bool symmetric = isSymmetric();
+	const int rows = symmetric ? height / 2 : height;
+	for (int i = 0; i < rows; ++i){
 		int *pdata = data + width * i;
-		float y = y_start + i * dy; // current imaginary value
-		
-		// Iterate limits
-		for (int l = 0; l < limit; ++l){
-
-			int limitCnt = 0;
-
-			// Iterate elements in the row
-			#pragma omp simd aligned(data, rBuffer, iBuffer: 64) reduction(+:limitCnt)
-			for (int j = 0; j < width; ++j){
-
-				float x = x_start + j * dx; // current real value
-
-				float zReal = (l == 0) ? x : rBuffer[j];
-				float zImag = (l == 0) ? y : iBuffer[j];
-
-				// Calculate limit
-				float r2 = zReal * zReal;
-				float i2 = zImag * zImag;
-				
-				// Calculate the condition
-				int cond = (r2 + i2) >= 4.0f;
-				pdata[j] += !cond;
-				limitCnt += cond;
-				
-				// Update values in buffers
-				!cond && (rBuffer[j] = (r2 - i2 + x));
-				!cond && (iBuffer[j] = (2.0f * zReal * zImag + y));
-			}
-
-			// Stop if the row is fully computed
-			if (limitCnt >= width) break;
-		}
+		T y = y_start + i * dy; // current imaginary value
+		MANDEL_INSTR(const auto rowStart = MandelInstrumentation::Clock::now();)
+
+		// Iterate limits of the row, escape is checked once per escapeCheckGroup iterations and the escaped
+		// elements are rolled back to their exact escape iteration (no reduction and masked stores in every iteration)
+		MandelKernels::grouped<escapeCheckGroup>(pdata, (const T*)xBuf, y, width, limit, rBuf, iBuf, escapedBuffer, f);
+		MANDEL_INSTR(instr.block(i, 0, pdata, width, limit);)
+		MANDEL_INSTR(instr.row(i, rowStart);)
+
+		// Copy the row to next half of the image
+		if (symmetric)
+			std::memcpy(data + (height-i-1) * width, data + (i * width), width * sizeof(int));
+	}
+	return data;
+}
+
+
+template <typename T>
+int * LineMandelCalculator::calculateWithShortcuts () {
+
+	T *rBuf = rBuffer.as<T>();
+	T *iBuf = iBuffer.as<T>();
+	T *prBuf = prBuffer.as<T>();
+	T *piBuf = piBuffer.as<T>();
+
+	// Iterate rows (due to symmetricity just half of the rows, the second half will be mem-copied)
+	const bool symmetric = isSymmetric();
+	const int rows = symmetric ? height / 2 : height;
+	for (int i = 0; i < rows; ++i){
+		int *pdata = data + width * i;
+		T y = y_start + i * dy; // current imaginary value
+
+		// Whole row is iterated together
+		MandelKernels::shortcutRow(pdata, 0, width, x_start, dx, y, limit, bulbTest, periodicityTest, rBuf, iBuf, prBuf, piBuf);
+
 		// Copy the row to next half of the image
-		std::memcpy(data + (height-i-1) * width, data + (i * width), width * sizeof(int));
+		if (symmetric)
+			std::memcpy(data + (height-i-1) * width, data + (i * width), width * sizeof(int));
 	}
 	return data;
 }
@@ -6,6 +6,8 @@
  */
 
 #include <BaseMandelCalculator.h>
+#include "ScratchBuffer.h"
+#include "MandelInstrumentation.h"
 
 class LineMandelCalculator : public BaseMandelCalculator
 {
@@ -14,8 +16,40 @@ public:
     ~LineMandelCalculator();
     int *calculateMandelbrot();
 
+#ifdef MANDEL_INSTRUMENT
+    /**
+     * @brief Statistics of the last calculation (the kernels with the interior shortcuts are not recorded)
+     */
+    const MandelInstrumentation &instrumentation() const { return instr; }
+#endif
+
 private:
+    /**
+     * @brief Selects the kernel instantiated for the formula
+     */
+    template <typename T>
+    int *dispatch();
+
+    template <typename T, class Formula>
+    int *calculate(const Formula &f);
+
+    /**
+     * @brief Variant of the kernel with the interior-point shortcuts (see setInteriorShortcuts())
+     */
+    template <typename T>
+    int *calculateWithShortcuts();
+
+    static const int escapeCheckGroup = 8; // iterations between escape checks of the row
+
     int *data;
-    float *rBuffer;
-    float *iBuffer;
+    ScratchBuffer rBuffer; // viewed as T* of the precision of the frame
+    ScratchBuffer iBuffer;
+    ScratchBuffer prBuffer; // saved point of the orbit for periodicity test (real)
+    ScratchBuffer piBuffer; // saved point of the orbit for periodicity test (imag)
+    ScratchBuffer xBuffer;  // real values of the columns
+    int *escapedBuffer; // elements rolled back by the grouped kernel
+
+#ifdef MANDEL_INSTRUMENT
+    MandelInstrumentation instr;
+#endif
 };
\ No newline at end of file
@@ -0,0 +1,53 @@
+/**
+ * @file MandelImage.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Read-only view of an iteration-count image that may store only the upper half of a symmetric image
+ * @date 17.10.2026
+ */
+#ifndef MANDELIMAGE_H
+#define MANDELIMAGE_H
+
+/**
+ * @brief View of width x height image whose first storedRows rows are in memory (row-major)
+ *
+ * If storedRows < height, row i >= storedRows is the mirror of row (height - 1 - i), so the bottom half is never
+ * materialized. Out is the type of the iteration count (int, uint16_t or uint8_t). The optional escape values
+ * (|z|^2 at the escape, e.g. TiledMandelCalculator::escapeValues()) have the same layout as data.
+ */
+template <typename Out>
+struct MandelImageView
+{
+    const Out *data;
+    int width;
+    int height;
+    int storedRows;
+    const float *escape = nullptr;
+
+    /**
+     * @brief True if the bottom half is mirrored from the stored rows
+     */
+    bool isHalf() const { return storedRows < height; }
+
+    /**
+     * @brief Row i of the full image (points to the stored row for the mirrored ones)
+     */
+    const Out *row(int i) const
+    {
+        return data + (i < storedRows ? i : height - 1 - i) * width;
+    }
+
+    /**
+     * @brief Row i of the escape values (nullptr if the view has none)
+     */
+    const float *escapeRow(int i) const
+    {
+        return escape ? escape + (i < storedRows ? i : height - 1 - i) * width : nullptr;
+    }
+
+    /**
+     * @brief Number of iterations of pixel in row i and column j
+     */
+    Out at(int i, int j) const { return row(i)[j]; }
+};
+
+#endif
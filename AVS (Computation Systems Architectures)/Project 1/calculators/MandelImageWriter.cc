@@ -0,0 +1,336 @@
+/**
+ * @file MandelImageWriter.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Vectorized colorization of iteration-count images written straight into memory-mapped PGM / PPM files
+ * @date 17.10.2026
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+
+#include <cstring>	    // memcpy()
+#include <fcntl.h>	    // open()
+#include <unistd.h>	    // ftruncate(), close()
+#include <sys/mman.h>	// mmap()
+
+#include "MandelImageWriter.h"
+
+
+MandelPalette MandelPalette::gradient(const std::vector<uint32_t> &colors, int size)
+{
+	MandelPalette palette;
+	palette.rgb.resize(3 * size);
+
+	const int segments = std::max(1, int(colors.size()) - 1);
+	for (int k = 0; k < size; ++k){
+		const double pos = (size > 1) ? double(k) * segments / (size - 1) : 0.0;
+		const int s = std::min(int(pos), segments - 1);
+		const double t = pos - s;
+		const uint32_t from = colors[std::min(s, int(colors.size()) - 1)];
+		const uint32_t to = colors[std::min(s + 1, int(colors.size()) - 1)];
+
+		for (int c = 0; c < 3; ++c){
+			const int shift = 16 - 8 * c;
+			const double a = (from >> shift) & 0xFF;
+			const double b = (to >> shift) & 0xFF;
+			palette.rgb[3 * k + c] = uint8_t(a + (b - a) * t + 0.5);
+		}
+	}
+	return palette;
+}
+
+MandelPalette MandelPalette::standard()
+{
+	return gradient({0x000764, 0x206BCB, 0xEDFFFF, 0xFFAA00, 0x000200});
+}
+
+
+namespace MandelImageWriter
+{
+
+// ln(2) / 2, log|z| = LN2_HALF * log2(|z|^2)
+static const float LN2_HALF = 0.34657359f;
+
+/**
+ * @brief log2(x) for normal x > 0 without calls, so the colorization loops vectorize (error below 1e-6)
+ *
+ * x = m * 2^e with m in [sqrt(1/2), sqrt(2)), ln(m) = 2 atanh(s) with s = (m - 1) / (m + 1), |s| < 0.172.
+ */
+static inline float log2Approx(float x)
+{
+	int bits;
+	std::memcpy(&bits, &x, sizeof(float));
+	int e = (bits >> 23) - 127;
+	bits = (bits & 0x007FFFFF) | 0x3F800000;
+
+	float m;
+	std::memcpy(&m, &bits, sizeof(float));
+	const int big = m > 1.41421356f;
+	m = big ? m * 0.5f : m;
+	e += big;
+
+	const float s = (m - 1.0f) / (m + 1.0f);
+	const float s2 = s * s;
+	const float lnm = 2.0f * s * (1.0f + s2 * (1.0f / 3.0f + s2 * (1.0f / 5.0f + s2 * (1.0f / 7.0f))));
+	return float(e) + lnm * 1.44269504f;
+}
+
+/**
+ * @brief Normalized iteration count n + 1 - log2(log|z|) of a point that escaped after n iterations with |z|^2 = z2
+ */
+static inline float normalizedCount(int n, float z2)
+{
+	return float(n) + 1.0f - log2Approx(LN2_HALF * log2Approx(z2));
+}
+
+template <typename Out>
+static void requireEscape(const MandelImageView<Out> &image, Coloring coloring)
+{
+	if (coloring == Coloring::NORMALIZED && !image.escape)
+		throw std::invalid_argument("MandelImageWriter: normalized coloring needs the escape values of the image");
+}
+
+/**
+ * @brief Output file of the given size mapped to memory, the header is written to its start
+ */
+struct MappedFile
+{
+	int fd = -1;
+	size_t size = 0;
+	uint8_t *data = nullptr;
+
+	bool open(const std::string &path, const std::string &header, size_t payload)
+	{
+		size = header.size() + payload;
+		fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (fd < 0) return false;
+		if (ftruncate(fd, size) != 0) return false;
+
+		void *map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (map == MAP_FAILED) return false;
+
+		data = (uint8_t*)map;
+		std::memcpy(data, header.data(), header.size());
+		return true;
+	}
+
+	~MappedFile()
+	{
+		if (data) munmap(data, size);
+		if (fd >= 0) close(fd);
+	}
+};
+
+/**
+ * @brief Colorizes the stored rows of the image into the mapped file and copies them to the mirrored rows
+ *
+ * @param out first byte of the pixels
+ * @param channels bytes per pixel
+ * @param colorize colorizes one row: colorize(int row, uint8_t *out)
+ */
+template <typename Out, typename Colorize>
+static void writeRows(uint8_t *out, const MandelImageView<Out> &image, int channels, const Colorize &colorize)
+{
+	const size_t rowBytes = size_t(image.width) * channels;
+
+	#pragma omp parallel
+	{
+		#pragma omp for schedule(static)
+		for (int i = 0; i < image.storedRows; ++i)
+			colorize(i, out + i * rowBytes);
+
+		// Mirrored rows are copied from the colorized ones (the barrier above finished them)
+		#pragma omp for schedule(static)
+		for (int i = image.storedRows; i < image.height; ++i)
+			std::memcpy(out + i * rowBytes, out + (image.height - 1 - i) * rowBytes, rowBytes);
+	}
+}
+
+
+template <typename Out>
+bool writePGM(const std::string &path, const MandelImageView<Out> &image, int limit, Coloring coloring)
+{
+	requireEscape(image, coloring);
+
+	MappedFile file;
+	const std::string header = "P5\n" + std::to_string(image.width) + " " + std::to_string(image.height) + "\n255\n";
+	if (!file.open(path, header, size_t(image.width) * image.height)) return false;
+
+	const int width = image.width;
+	const float scale = 255.0f / log2Approx(float(limit) + 1.0f);
+
+	writeRows(file.data + header.size(), image, 1, [=](int i, uint8_t *dst){
+		const Out *src = image.row(i);
+		if (coloring == Coloring::NORMALIZED){
+			const float *z2 = image.escapeRow(i);
+			#pragma omp simd
+			for (int j = 0; j < width; ++j){
+				const int n = src[j];
+				const float pos = std::min(scale * log2Approx(normalizedCount(n, z2[j]) + 1.0f), 255.0f);
+				dst[j] = uint8_t(int(pos + 0.5f) & -(n < limit));
+			}
+		}
+		else if (coloring == Coloring::LOG){
+			#pragma omp simd
+			for (int j = 0; j < width; ++j){
+				const int n = src[j];
+				const int gray = int(scale * log2Approx(float(n) + 1.0f) + 0.5f);
+				dst[j] = uint8_t(gray & -(n < limit));
+			}
+		}
+		else {
+			#pragma omp simd
+			for (int j = 0; j < width; ++j){
+				const int n = src[j];
+				dst[j] = uint8_t(n & 0xFF & -(n < limit));
+			}
+		}
+	});
+	return true;
+}
+
+
+/**
+ * @brief Colorizes rows with the palette (channels are gathered as floats by the AVX2 gathers)
+ */
+class RgbColorizer
+{
+public:
+	RgbColorizer(const MandelPalette &palette, int limit, Coloring coloring) :
+		size(palette.size()), limit(limit), coloring(coloring), channels(3 * (palette.size() + 1))
+	{
+		// The last color is repeated for the interpolation at the end of the palette
+		for (int k = 0; k <= size; ++k){
+			const int c = std::min(k, size - 1);
+			channels[k] = palette.rgb[3 * c];
+			channels[size + 1 + k] = palette.rgb[3 * c + 1];
+			channels[2 * (size + 1) + k] = palette.rgb[3 * c + 2];
+		}
+		scale = float(size - 1) / log2Approx(float(limit) + 1.0f);
+	}
+
+	/**
+	 * @brief Colorizes width pixels of a row (escape is its row of escape values, used only by NORMALIZED)
+	 */
+	template <typename Out>
+	void operator()(const Out *src, const float *escape, uint8_t *dst, int width) const
+	{
+		const float *palR = channels.data();
+		const float *palG = palR + size + 1;
+		const float *palB = palG + size + 1;
+
+		if (coloring == Coloring::NORMALIZED){
+			// mu is at most n + 1.53, so the position is clamped to the last color (bound is hoisted, the stores of
+			// uint8_t may alias the members and GCC would not vectorize the loop)
+			const float maxPos = float(size - 1);
+
+			#pragma omp simd
+			for (int j = 0; j < width; ++j){
+				const int n = src[j];
+				const float pos = std::min(scale * log2Approx(normalizedCount(n, escape[j]) + 1.0f), maxPos);
+				const int k = int(pos);
+				const float t = pos - float(k);
+				const int keep = -(n < limit);
+
+				const float r = palR[k] + t * (palR[k + 1] - palR[k]);
+				const float g = palG[k] + t * (palG[k + 1] - palG[k]);
+				const float b = palB[k] + t * (palB[k + 1] - palB[k]);
+				dst[3 * j]     = uint8_t(int(r + 0.5f) & keep);
+				dst[3 * j + 1] = uint8_t(int(g + 0.5f) & keep);
+				dst[3 * j + 2] = uint8_t(int(b + 0.5f) & keep);
+			}
+		}
+		else if (coloring == Coloring::LOG){
+			#pragma omp simd
+			for (int j = 0; j < width; ++j){
+				const int n = src[j];
+				const float pos = scale * log2Approx(float(n) + 1.0f);
+				const int k = int(pos);
+				const float t = pos - float(k);
+				const int keep = -(n < limit); // points of the set are black (a select is not vectorized by GCC)
+
+				const float r = palR[k] + t * (palR[k + 1] - palR[k]);
+				const float g = palG[k] + t * (palG[k + 1] - palG[k]);
+				const float b = palB[k] + t * (palB[k + 1] - palB[k]);
+				dst[3 * j]     = uint8_t(int(r + 0.5f) & keep);
+				dst[3 * j + 1] = uint8_t(int(g + 0.5f) & keep);
+				dst[3 * j + 2] = uint8_t(int(b + 0.5f) & keep);
+			}
+		}
+		else {
+			#pragma omp simd
+			for (int j = 0; j < width; ++j){
+				const int n = src[j];
+				const int k = n % size;
+				const int keep = -(n < limit);
+				dst[3 * j]     = uint8_t(int(palR[k]) & keep);
+				dst[3 * j + 1] = uint8_t(int(palG[k]) & keep);
+				dst[3 * j + 2] = uint8_t(int(palB[k]) & keep);
+			}
+		}
+	}
+
+private:
+	const int size;
+	const int limit;
+	const Coloring coloring;
+	std::vector<float> channels; // red, green and blue channel, size + 1 elements each
+	float scale;
+};
+
+
+template <typename Out>
+bool writePPM(const std::string &path, const MandelImageView<Out> &image, int limit, const MandelPalette &palette,
+              Coloring coloring)
+{
+	requireEscape(image, coloring);
+
+	MappedFile file;
+	const std::string header = "P6\n" + std::to_string(image.width) + " " + std::to_string(image.height) + "\n255\n";
+	if (!file.open(path, header, size_t(image.width) * image.height * 3)) return false;
+
+	const RgbColorizer colorize(palette, limit, coloring);
+	const int width = image.width;
+
+	writeRows(file.data + header.size(), image, 3, [&](int i, uint8_t *dst){
+		colorize(image.row(i), image.escapeRow(i), dst, width);
+	});
+	return true;
+}
+
+
+template <typename Out>
+std::string encodePPM(const MandelImageView<Out> &image, int rowStart, int colStart, int rows, int cols, int limit,
+                      const MandelPalette &palette, Coloring coloring)
+{
+	requireEscape(image, coloring);
+
+	const std::string header = "P6\n" + std::to_string(cols) + " " + std::to_string(rows) + "\n255\n";
+	std::string encoded(header.size() + size_t(rows) * cols * 3, '\0');
+	std::memcpy(&encoded[0], header.data(), header.size());
+
+	const RgbColorizer colorize(palette, limit, coloring);
+	uint8_t *out = (uint8_t*)&encoded[header.size()];
+	for (int i = 0; i < rows; ++i){
+		const float *escape = image.escapeRow(rowStart + i);
+		colorize(image.row(rowStart + i) + colStart, escape ? escape + colStart : nullptr, out + size_t(i) * cols * 3, cols);
+	}
+	return encoded;
+}
+
+
+template bool writePGM<int>(const std::string &, const MandelImageView<int> &, int, Coloring);
+template bool writePGM<uint16_t>(const std::string &, const MandelImageView<uint16_t> &, int, Coloring);
+template bool writePGM<uint8_t>(const std::string &, const MandelImageView<uint8_t> &, int, Coloring);
+template bool writePPM<int>(const std::string &, const MandelImageView<int> &, int, const MandelPalette &, Coloring);
+template bool writePPM<uint16_t>(const std::string &, const MandelImageView<uint16_t> &, int, const MandelPalette &, Coloring);
+template bool writePPM<uint8_t>(const std::string &, const MandelImageView<uint8_t> &, int, const MandelPalette &, Coloring);
+template std::string encodePPM<int>(const MandelImageView<int> &, int, int, int, int, int, const MandelPalette &, Coloring);
+template std::string encodePPM<uint16_t>(const MandelImageView<uint16_t> &, int, int, int, int, int, const MandelPalette &, Coloring);
+template std::string encodePPM<uint8_t>(const MandelImageView<uint8_t> &, int, int, int, int, int, const MandelPalette &, Coloring);
+
+} // namespace MandelImageWriter
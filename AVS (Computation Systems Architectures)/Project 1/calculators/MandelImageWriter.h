@@ -0,0 +1,93 @@
+/**
+ * @file MandelImageWriter.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Vectorized colorization of iteration-count images written straight into memory-mapped PGM / PPM files
+ * @date 17.10.2026
+ */
+#ifndef MANDELIMAGEWRITER_H
+#define MANDELIMAGEWRITER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "MandelImage.h"
+
+/**
+ * @brief Palette of RGB colors, position 0 is used for the points that escape first
+ */
+struct MandelPalette
+{
+    std::vector<uint8_t> rgb; // 3 bytes per color
+
+    int size() const { return int(rgb.size() / 3); }
+
+    /**
+     * @brief Palette interpolated linearly through the given colors (0xRRGGBB)
+     */
+    static MandelPalette gradient(const std::vector<uint32_t> &colors, int size = 256);
+
+    /**
+     * @brief Default blue - white - orange palette
+     */
+    static MandelPalette standard();
+};
+
+namespace MandelImageWriter
+{
+
+/**
+ * @brief Mapping of the iteration count to the palette (points of the set, count == limit, are always black)
+ *
+ * PALETTE     the count selects the color directly (palette repeats every size() iterations, bands are visible)
+ * LOG         log(1 + count) / log(1 + limit) is the position in the palette, neighbouring colors are interpolated
+ *             (log-scaled integer counts, the bands between the counts remain)
+ * NORMALIZED  smooth coloring, the normalized iteration count mu = count + 1 - log2(log|z|) of the escape |z|
+ *             replaces the count of LOG, requires the escape values of the image (MandelImageView::escape) and
+ *             assumes a quadratic formula (Mandelbrot, Julia, Burning Ship)
+ */
+enum class Coloring { PALETTE, LOG, NORMALIZED };
+
+/**
+ * @brief Writes a grayscale PGM (P5) image, gray level follows the same mapping as the palette position
+ *
+ * @return false if the file can not be created or mapped
+ * @throw std::invalid_argument NORMALIZED coloring of an image without escape values
+ */
+template <typename Out>
+bool writePGM(const std::string &path, const MandelImageView<Out> &image, int limit, Coloring coloring = Coloring::LOG);
+
+/**
+ * @brief Writes an RGB PPM (P6) image colored by the palette
+ *
+ * Rows are colorized in parallel directly into the mapped file. Rows of a half image (see MandelImageView) are
+ * colorized once and the mirrored rows are copied within the file.
+ *
+ * @return false if the file can not be created or mapped
+ * @throw std::invalid_argument NORMALIZED coloring of an image without escape values
+ */
+template <typename Out>
+bool writePPM(const std::string &path, const MandelImageView<Out> &image, int limit, const MandelPalette &palette,
+              Coloring coloring = Coloring::LOG);
+
+/**
+ * @brief Encodes the region [rowStart, rowStart + rows) x [colStart, colStart + cols) of the image as a PPM (P6) file
+ * in memory (e.g. a map tile), colored the same way as by writePPM()
+ *
+ * @throw std::invalid_argument NORMALIZED coloring of an image without escape values
+ */
+template <typename Out>
+std::string encodePPM(const MandelImageView<Out> &image, int rowStart, int colStart, int rows, int cols, int limit,
+                      const MandelPalette &palette, Coloring coloring = Coloring::LOG);
+
+/**
+ * @brief View of a full int image returned by calculateMandelbrot()
+ */
+inline MandelImageView<int> fullView(const int *data, int width, int height)
+{
+    return MandelImageView<int>{data, width, height, height};
+}
+
+} // namespace MandelImageWriter
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * @file MandelInstrumentation.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Opt-in instrumentation of the Line and Batch kernels (lane utilization, iterations per block, time per row)
+ * @date 17.10.2026
+ */
+
+#include "MandelInstrumentation.h"
+
+#ifdef MANDEL_INSTRUMENT
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+
+void MandelInstrumentation::reset(int lanes)
+{
+	histogram.assign(lanes + 1, 0);
+	blocks.clear();
+	rows.clear();
+	rowIterations = 0;
+}
+
+
+void MandelInstrumentation::block(int row, int blockStart, const int *counts, int lanes, int limit)
+{
+	if (lanes <= 0) return;
+	if (lanes >= (int)histogram.size()) histogram.resize(lanes + 1, 0);
+
+	sorted.assign(counts, counts + lanes);
+	std::sort(sorted.begin(), sorted.end());
+
+	// The block checks the escape once more after its last lane escaped (all lanes are inactive then)
+	const int blockIterations = std::min(limit, sorted.back() + 1);
+
+	long long laneIterations = 0;
+	int previous = 0;
+	for (int k = 0; k < lanes; ++k){
+		const int count = std::min(sorted[k], blockIterations);
+		histogram[lanes - k] += count - previous;
+		previous = count;
+		laneIterations += sorted[k];
+	}
+	histogram[0] += blockIterations - previous;
+
+	blocks.push_back(BlockRecord{row, blockStart, lanes, blockIterations, laneIterations, sorted.front(), sorted.back()});
+	rowIterations += laneIterations;
+}
+
+
+void MandelInstrumentation::row(int row, Clock::time_point start)
+{
+	const double timeUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+	rows.push_back(RowRecord{row, timeUs, rowIterations});
+	rowIterations = 0;
+}
+
+
+bool MandelInstrumentation::dump(const std::string &prefix) const
+{
+	std::ofstream rowsOut(prefix + "_rows.csv");
+	rowsOut << "row;time_us;iterations" << std::endl;
+	for (const RowRecord &r : rows)
+		rowsOut << r.row << ";" << r.timeUs << ";" << r.iterations << std::endl;
+
+	// Utilization = useful lane iterations / (lanes * iterations of the block)
+	std::ofstream blocksOut(prefix + "_blocks.csv");
+	blocksOut << "row;block_start;lanes;block_iterations;lane_iterations;min_count;max_count;utilization" << std::endl;
+	for (const BlockRecord &b : blocks){
+		const double utilization = b.blockIterations > 0 ? double(b.laneIterations) / (double(b.lanes) * b.blockIterations) : 1.0;
+		blocksOut << b.row << ";" << b.blockStart << ";" << b.lanes << ";" << b.blockIterations << ";" << b.laneIterations
+		          << ";" << b.minCount << ";" << b.maxCount << ";" << utilization << std::endl;
+	}
+
+	std::ofstream lanesOut(prefix + "_lanes.csv");
+	lanesOut << "active_lanes;iterations" << std::endl;
+	for (size_t active = 0; active < histogram.size(); ++active)
+		if (histogram[active] > 0)
+			lanesOut << active << ";" << histogram[active] << std::endl;
+
+	return bool(rowsOut) && bool(blocksOut) && bool(lanesOut);
+}
+
+#endif
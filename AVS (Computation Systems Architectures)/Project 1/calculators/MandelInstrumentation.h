@@ -0,0 +1,93 @@
+/**
+ * @file MandelInstrumentation.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Opt-in instrumentation of the Line and Batch kernels (lane utilization, iterations per block, time per row)
+ * @date 17.10.2026
+ *
+ * Enabled by compiling with -DMANDEL_INSTRUMENT. Otherwise MANDEL_INSTR(...) expands to nothing and the calculators
+ * are compiled exactly as without the instrumentation.
+ */
+#ifndef MANDELINSTRUMENTATION_H
+#define MANDELINSTRUMENTATION_H
+
+#ifdef MANDEL_INSTRUMENT
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+#define MANDEL_INSTR(...) __VA_ARGS__
+
+/**
+ * @brief Statistics of one calculation (reset by every calculateMandelbrot(), mirrored rows are not recorded)
+ *
+ * Activity of the lanes is derived from the iteration counts of a finished block: lane with count c is active in
+ * iterations [0, c) and the block runs until its last lane escapes (the grouped kernels iterate up to
+ * group - 1 iterations more). Recording happens outside of the vectorized loops, so it does not change them.
+ * Not thread safe (Line and Batch calculators are sequential).
+ */
+class MandelInstrumentation
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Clears the statistics, lanes = the largest block
+     */
+    void reset(int lanes);
+
+    /**
+     * @brief Records a finished block of lanes elements of the row starting at blockStart
+     */
+    void block(int row, int blockStart, const int *counts, int lanes, int limit);
+
+    /**
+     * @brief Records time of the row (its blocks have to be recorded before)
+     */
+    void row(int row, Clock::time_point start);
+
+    /**
+     * @brief Writes prefix_rows.csv, prefix_blocks.csv and prefix_lanes.csv
+     *
+     * @return false if a file can not be written
+     */
+    bool dump(const std::string &prefix) const;
+
+    /**
+     * @brief Iterations of the blocks with the given number of active lanes (index = active lanes)
+     */
+    const std::vector<long long> &laneHistogram() const { return histogram; }
+
+private:
+    struct BlockRecord
+    {
+        int row;
+        int blockStart;
+        int lanes;
+        int blockIterations;      // iterations until the last lane escaped
+        long long laneIterations; // iterations of all lanes (useful work)
+        int minCount;
+        int maxCount;
+    };
+
+    struct RowRecord
+    {
+        int row;
+        double timeUs;
+        long long iterations;
+    };
+
+    std::vector<long long> histogram;
+    std::vector<BlockRecord> blocks;
+    std::vector<RowRecord> rows;
+    long long rowIterations = 0;
+    std::vector<int> sorted; // scratch for the counts of a block
+};
+
+#else
+
+#define MANDEL_INSTR(...)
+
+#endif
+
+#endif
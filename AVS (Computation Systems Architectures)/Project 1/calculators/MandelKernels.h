@@ -0,0 +1,354 @@
+/**
+ * @file MandelKernels.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Vectorized Mandelbrot kernels shared by the calculators
+ * @date 17.10.2026
+ */
+#ifndef MANDELKERNELS_H
+#define MANDELKERNELS_H
+
+#include <algorithm>
+
+#include "FpContract.h"	// the kernels and the code after them are compiled without FMA contraction
+#include "Formulas.h"
+#include "BaseMandelCalculator.h"
+
+namespace MandelKernels
+{
+
+static const int blockSize = 64; // batch size (the same as in BatchMandelCalculator)
+
+/**
+ * @brief Computes number of iterations for arbitrary points given as separate real and imaginary arrays (SoA)
+ *
+ * Points are processed in batches of blockSize lanes, the batch ends when all its lanes escaped.
+ *
+ * @param cReal real parts of the points
+ * @param cImag imaginary parts of the points
+ * @param out number of iterations for each point
+ * @param count number of points
+ * @param limit maximal number of iterations
+ * @param rBuffer scratch buffer (at least blockSize elements)
+ * @param iBuffer scratch buffer (at least blockSize elements)
+ * @param formula iterated formula (see Formulas.h)
+ */
+template <typename T, class Formula = Formulas::Mandelbrot>
+static inline void points(const T *cReal, const T *cImag, int *out, int count, int limit, T *rBuffer, T *iBuffer,
+                          const Formula &formula = Formula())
+{
+    const T bailout = T(formula.bailout());
+
+    for (int blockStart = 0; blockStart < count; blockStart += blockSize)
+    {
+        const int n = std::min(blockSize, count - blockStart);
+        const T *pReal = cReal + blockStart;
+        const T *pImag = cImag + blockStart;
+        int *pOut = out + blockStart;
+
+        #pragma omp simd
+        for (int j = 0; j < n; ++j)
+        {
+            pOut[j] = 0;
+            rBuffer[j] = pReal[j];
+            iBuffer[j] = pImag[j];
+        }
+
+        for (int l = 0; l < limit; ++l)
+        {
+            int limitCnt = 0;
+
+            #pragma omp simd reduction(+:limitCnt)
+            for (int j = 0; j < n; ++j)
+            {
+                T zReal = rBuffer[j];
+                T zImag = iBuffer[j];
+
+                int cond = (zReal * zReal + zImag * zImag) >= bailout;
+                pOut[j] += !cond;
+                limitCnt += cond;
+
+                formula.step(zReal, zImag, pReal[j], pImag[j]);
+                !cond && (rBuffer[j] = zReal);
+                !cond && (iBuffer[j] = zImag);
+            }
+
+            if (limitCnt >= n) break;
+        }
+    }
+}
+
+/**
+ * @brief Computes number of iterations for columns [colStart, colEnd) of one row in batches of blockSize lanes
+ *
+ * Real value of column j is xStart + j * dx, the same as in the calculators. Iterations are counted in int lanes
+ * and stored to the output type (int, uint16_t, uint8_t) once per block, the output must be able to hold limit.
+ *
+ * @param pdata output row
+ * @param colStart first column
+ * @param colEnd end of the columns (exclusive)
+ * @param xStart minimal real value
+ * @param dx step of real values
+ * @param y imaginary value of the row
+ * @param limit maximal number of iterations
+ * @param rBuffer scratch buffer (at least blockSize elements)
+ * @param iBuffer scratch buffer (at least blockSize elements)
+ * @param formula iterated formula (see Formulas.h)
+ * @param escape optional output row of |z|^2 at the escape (the last z for points of the set), indexed as pdata
+ */
+template <typename T, typename Out, class Formula = Formulas::Mandelbrot>
+static inline void row(Out *pdata, int colStart, int colEnd, double xStart, double dx, T y, int limit, T *rBuffer, T *iBuffer,
+                       const Formula &formula = Formula(), float *escape = nullptr)
+{
+    const T bailout = T(formula.bailout());
+
+    // Real values of the block are loaded from memory, computing them from the index in the loop blocks vectorization (GCC)
+    alignas(64) T cReal[blockSize];
+    alignas(64) int pBlock[blockSize];
+
+    for (int blockStart = colStart; blockStart < colEnd; blockStart += blockSize)
+    {
+        const int n = std::min(blockSize, colEnd - blockStart);
+
+        #pragma omp simd
+        for (int j = 0; j < n; ++j)
+        {
+            pBlock[j] = 0;
+            cReal[j] = xStart + (blockStart + j) * dx;
+            rBuffer[j] = cReal[j];
+            iBuffer[j] = y;
+        }
+
+        for (int l = 0; l < limit; ++l)
+        {
+            int limitCnt = 0;
+
+            #pragma omp simd reduction(+:limitCnt)
+            for (int j = 0; j < n; ++j)
+            {
+                T x = cReal[j];
+
+                T zReal = rBuffer[j];
+                T zImag = iBuffer[j];
+
+                int cond = (zReal * zReal + zImag * zImag) >= bailout;
+                pBlock[j] += !cond;
+                limitCnt += cond;
+
+                formula.step(zReal, zImag, x, y);
+                !cond && (rBuffer[j] = zReal);
+                !cond && (iBuffer[j] = zImag);
+            }
+
+            if (limitCnt >= n) break;
+        }
+
+        #pragma omp simd
+        for (int j = 0; j < n; ++j)
+            pdata[blockStart + j] = Out(pBlock[j]);
+
+        // Escaped lanes keep the first z beyond the bailout in the buffers
+        if (escape)
+        {
+            #pragma omp simd
+            for (int j = 0; j < n; ++j)
+                escape[blockStart + j] = float(rBuffer[j] * rBuffer[j] + iBuffer[j] * iBuffer[j]);
+        }
+    }
+}
+
+/**
+ * @brief Computes number of iterations of points with the same imaginary value, escape is checked once per group
+ *
+ * Every lane runs group iterations unconditionally in registers, then the lanes whose |z| reached the bailout within
+ * the group are rolled back to the start of the group and replayed one by one up to their exact escape iteration.
+ * Once |z| reaches the bailout it never decreases (see Formulas.h), so the test at the end of the group finds all
+ * escapes and overflow to inf / NaN fails the test too. The remainder of the limit is iterated with the check in
+ * every iteration. Results are the same as of row() (no FMA contraction, see FpContract.h).
+ *
+ * @param out number of iterations for each point
+ * @param cReal real parts of the points
+ * @param y imaginary value of the points
+ * @param count number of points
+ * @param limit maximal number of iterations
+ * @param rBuffer scratch buffer (at least count elements)
+ * @param iBuffer scratch buffer (at least count elements)
+ * @param escaped scratch buffer (at least count elements), lanes that escaped within the last group
+ * @param formula iterated formula (see Formulas.h)
+ */
+template <int group, typename T, typename Out, class Formula = Formulas::Mandelbrot>
+static inline void grouped(Out *out, const T *cReal, T y, int count, int limit, T *rBuffer, T *iBuffer, int *escaped,
+                           const Formula &formula = Formula())
+{
+    const T bailout = T(formula.bailout());
+
+    #pragma omp simd
+    for (int j = 0; j < count; ++j)
+    {
+        out[j] = 0;
+        rBuffer[j] = cReal[j];
+        iBuffer[j] = y;
+    }
+
+    int l = 0;
+    for (; l + group <= limit; l += group)
+    {
+        int escapedCnt = 0;
+        int runningCnt = 0;
+
+        #pragma omp simd reduction(+:escapedCnt, runningCnt)
+        for (int j = 0; j < count; ++j)
+        {
+            const T x = cReal[j];
+            const T zReal0 = rBuffer[j];
+            const T zImag0 = iBuffer[j];
+
+            // Lanes that escaped before have |z| above the bailout stored
+            const int running = (zReal0 * zReal0 + zImag0 * zImag0) < bailout;
+
+            // Group loop has to be unrolled before vectorization (it is not done at -O2 otherwise)
+            T zReal = zReal0;
+            T zImag = zImag0;
+            #pragma GCC unroll 32
+            for (int u = 0; u < group; ++u)
+                formula.step(zReal, zImag, x, y);
+
+            const int inside = running & ((zReal * zReal + zImag * zImag) < bailout);
+            out[j] += inside ? group : 0;
+            rBuffer[j] = inside ? zReal : zReal0;
+            iBuffer[j] = inside ? zImag : zImag0;
+            escaped[j] = running & !inside;
+
+            escapedCnt += running & !inside;
+            runningCnt += inside;
+        }
+
+        // Roll back: lanes that escaped within the group are replayed from its start with the check in every iteration
+        if (escapedCnt > 0)
+        {
+            for (int j = 0; j < count; ++j)
+            {
+                if (!escaped[j]) continue;
+
+                const T x = cReal[j];
+                T zReal = rBuffer[j];
+                T zImag = iBuffer[j];
+                int cnt = out[j];
+                for (int u = 0; u < group; ++u)
+                {
+                    if (zReal * zReal + zImag * zImag >= bailout) break;
+                    ++cnt;
+                    formula.step(zReal, zImag, x, y);
+                }
+                out[j] = cnt;
+                rBuffer[j] = zReal;
+                iBuffer[j] = zImag;
+            }
+        }
+
+        if (runningCnt == 0) return;
+    }
+
+    // Remainder of the limit (lanes that escaped have |z| above the bailout stored, so they do not change)
+    for (; l < limit; ++l)
+    {
+        int limitCnt = 0;
+
+        #pragma omp simd reduction(+:limitCnt)
+        for (int j = 0; j < count; ++j)
+        {
+            T zReal = rBuffer[j];
+            T zImag = iBuffer[j];
+
+            int cond = (zReal * zReal + zImag * zImag) >= bailout;
+            out[j] += !cond;
+            limitCnt += cond;
+
+            formula.step(zReal, zImag, cReal[j], y);
+            !cond && (rBuffer[j] = zReal);
+            !cond && (iBuffer[j] = zImag);
+        }
+
+        if (limitCnt >= count) break;
+    }
+}
+
+/**
+ * @brief Computes number of iterations of the Mandelbrot set for columns [colStart, colEnd) of one row with the
+ * interior-point shortcuts (see BaseMandelCalculator::setInteriorShortcuts()), all columns are iterated together
+ *
+ * Points in the main cardioid or the period-2 bulb are set to limit before iterating (bulb). A lane whose orbit
+ * returns to its saved point is a cycle and is set to limit too (periodicity), the saved point moves at powers of two
+ * (Brent). Finished lanes get z = 2, so they never pass the escape condition again.
+ *
+ * @param pdata output row
+ * @param colStart first column
+ * @param colEnd end of the columns (exclusive)
+ * @param xStart minimal real value
+ * @param dx step of real values
+ * @param y imaginary value of the row
+ * @param limit maximal number of iterations
+ * @param bulb test of the cardioid and the bulb (int, so the compiler sees it as a constant of the vectorized loops)
+ * @param periodicity cycle detection
+ * @param rBuffer scratch buffer (at least colEnd - colStart elements)
+ * @param iBuffer scratch buffer (at least colEnd - colStart elements)
+ * @param prBuffer saved point of the orbit (at least colEnd - colStart elements)
+ * @param piBuffer saved point of the orbit (at least colEnd - colStart elements)
+ */
+template <typename T>
+static inline void shortcutRow(int *pdata, int colStart, int colEnd, double xStart, double dx, T y, int limit, int bulb,
+                               int periodicity, T *rBuffer, T *iBuffer, T *prBuffer, T *piBuffer)
+{
+    const int count = colEnd - colStart;
+    int *pOut = pdata + colStart;
+
+    #pragma omp simd
+    for (int j = 0; j < count; ++j)
+    {
+        T x = xStart + (colStart + j) * dx;
+        int inside = bulb & BaseMandelCalculator::isInsideBulb(x, y);
+        pOut[j] = inside ? limit : 0;
+        rBuffer[j] = prBuffer[j] = inside ? T(2.0) : x;
+        iBuffer[j] = piBuffer[j] = inside ? T(0.0) : y;
+    }
+
+    for (int l = 0; l < limit; ++l)
+    {
+        int limitCnt = 0;
+        const int save = periodicity & ((l & (l - 1)) == 0);
+
+        #pragma omp simd reduction(+:limitCnt)
+        for (int j = 0; j < count; ++j)
+        {
+            T x = xStart + (colStart + j) * dx;
+
+            T zReal = rBuffer[j];
+            T zImag = iBuffer[j];
+
+            T r2 = zReal * zReal;
+            T i2 = zImag * zImag;
+
+            int cond = (r2 + i2) >= T(4.0);
+            T newReal = r2 - i2 + x;
+            T newImag = T(2.0) * zReal * zImag + y;
+
+            // Orbit returned to the saved point, it is a cycle and the point never escapes
+            int periodic = periodicity & !cond & (newReal == prBuffer[j]) & (newImag == piBuffer[j]);
+            pOut[j] = periodic ? limit : pOut[j] + !cond;
+            limitCnt += cond | periodic;
+
+            newReal = periodic ? T(2.0) : newReal;
+            newImag = periodic ? T(0.0) : newImag;
+
+            !cond && (rBuffer[j] = newReal);
+            !cond && (iBuffer[j] = newImag);
+            (save & !cond) && (prBuffer[j] = newReal);
+            (save & !cond) && (piBuffer[j] = newImag);
+        }
+
+        if (limitCnt >= count) break;
+    }
+}
+
+} // namespace MandelKernels
+
+#endif
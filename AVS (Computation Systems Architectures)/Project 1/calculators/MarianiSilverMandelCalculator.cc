@@ -0,0 +1,192 @@
+/**
+ * @file MarianiSilverMandelCalculator.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator that traces borders of rectangles and fills uniform ones (Mariani-Silver)
+ * @date 17.10.2026
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <stdlib.h>
+
+#include <immintrin.h>	// _mm_malloc()
+#include <cstring>	    // memcpy()
+
+#include "MandelKernels.h"
+#include "MarianiSilverMandelCalculator.h"
+
+
+MarianiSilverMandelCalculator::MarianiSilverMandelCalculator (unsigned matrixBaseSize, unsigned limit, bool halfImage) :
+	BaseMandelCalculator(matrixBaseSize, limit, "MarianiSilverMandelCalculator"), halfImage(halfImage)
+{
+	cVariant = halfImage ? "half" : "full";
+
+	data = (int*)(_mm_malloc(height * width * sizeof(int), 64));
+	idxBuffer = (int*)(_mm_malloc(chunkSize * sizeof(int), 64));
+	outBuffer = (int*)(_mm_malloc(chunkSize * sizeof(int), 64));
+	crBuffer = ScratchBuffer(chunkSize);
+	ciBuffer = ScratchBuffer(chunkSize);
+	rBuffer = ScratchBuffer(MandelKernels::blockSize);
+	iBuffer = ScratchBuffer(MandelKernels::blockSize);
+}
+
+MarianiSilverMandelCalculator::~MarianiSilverMandelCalculator() {
+	_mm_free(data);
+	_mm_free(idxBuffer);
+	_mm_free(outBuffer);
+	data = nullptr;
+	idxBuffer = nullptr;
+	outBuffer = nullptr;
+}
+
+
+void MarianiSilverMandelCalculator::computePixels(const int *idx, int count) {
+
+	int n = 0;
+	for (int k = 0; k <= count; ++k){
+
+		// Pass full chunk (or the rest) to the kernel and store the results
+		if (n == chunkSize || (k == count && n > 0)){
+			if (doublePrecision)
+				MandelKernels::points(crBuffer.as<double>(), ciBuffer.as<double>(), outBuffer, n, limit, rBuffer.as<double>(), iBuffer.as<double>());
+			else
+				MandelKernels::points(crBuffer.as<float>(), ciBuffer.as<float>(), outBuffer, n, limit, rBuffer.as<float>(), iBuffer.as<float>());
+			for (int p = 0; p < n; ++p)
+				data[idxBuffer[p]] = outBuffer[p];
+			n = 0;
+		}
+		if (k == count) break;
+
+		// Pixels shared by neighbouring rectangles are computed only once
+		const int index = idx[k];
+		if (data[index] >= 0) continue;
+
+		idxBuffer[n] = index;
+		if (doublePrecision){
+			crBuffer.as<double>()[n] = x_start + (index % width) * dx;
+			ciBuffer.as<double>()[n] = y_start + (index / width) * dy;
+		} else {
+			crBuffer.as<float>()[n] = x_start + (index % width) * dx;
+			ciBuffer.as<float>()[n] = y_start + (index / width) * dy;
+		}
+		++n;
+	}
+}
+
+
+void MarianiSilverMandelCalculator::computeRowSegment(int y, int x0, int x1) {
+
+	int *prow = data + y * width;
+	for (int x = x0; x <= x1;){
+		// Pixels shared by neighbouring rectangles are computed only once
+		if (prow[x] >= 0){
+			++x;
+			continue;
+		}
+
+		int end = x;
+		while (end <= x1 && prow[end] < 0) ++end;
+
+		if (doublePrecision)
+			MandelKernels::row(prow, x, end, x_start, dx, double(y_start + y * dy), limit, rBuffer.as<double>(), iBuffer.as<double>());
+		else
+			MandelKernels::row(prow, x, end, x_start, dx, float(y_start + y * dy), limit, rBuffer.as<float>(), iBuffer.as<float>());
+		x = end;
+	}
+}
+
+
+bool MarianiSilverMandelCalculator::traceBorder(const Rect &rect) {
+
+	// Horizontal edges are contiguous in memory (row kernel), the vertical ones are gathered
+	computeRowSegment(rect.y0, rect.x0, rect.x1);
+	computeRowSegment(rect.y1, rect.x0, rect.x1);
+
+	std::vector<int> edges;
+	edges.reserve(2 * (rect.y1 - rect.y0));
+	for (int y = rect.y0 + 1; y < rect.y1; ++y){
+		edges.push_back(y * width + rect.x0);
+		edges.push_back(y * width + rect.x1);
+	}
+	computePixels(edges.data(), edges.size());
+
+	const int value = data[rect.y0 * width + rect.x0];
+	for (int x = rect.x0; x <= rect.x1; ++x){
+		if (data[rect.y0 * width + x] != value || data[rect.y1 * width + x] != value) return false;
+	}
+	for (int index : edges){
+		if (data[index] != value) return false;
+	}
+	return true;
+}
+
+
+int * MarianiSilverMandelCalculator::calculateMandelbrot () {
+
+	// Float kernel is used while the pixel spacing allows it
+	doublePrecision = needsDoublePrecision();
+
+	// Due to symmetricity just half of the rows can be traced, the second half will be mem-copied
+	const bool mirror = halfImage && isSymmetric();
+	const int rows = mirror ? height / 2 : height;
+
+	// -1 marks pixels that were not computed yet
+	std::fill(data, data + rows * width, -1);
+
+	std::vector<Rect> stack;
+	stack.push_back({0, 0, width - 1, rows - 1});
+
+	std::vector<int> pixels;
+	while (!stack.empty()){
+		const Rect rect = stack.back();
+		stack.pop_back();
+
+		const int w = rect.x1 - rect.x0 + 1;
+		const int h = rect.y1 - rect.y0 + 1;
+
+		// Small rectangles are computed completely, row by row if the rows are wider than minRectSize, narrow ones
+		// are gathered (their rows would fill only a part of a vector, 2.5x slower in total)
+		if (w <= minRectSize || h <= minRectSize){
+			if (w > minRectSize){
+				for (int y = rect.y0; y <= rect.y1; ++y)
+					computeRowSegment(y, rect.x0, rect.x1);
+				continue;
+			}
+			pixels.clear();
+			for (int y = rect.y0; y <= rect.y1; ++y)
+				for (int x = rect.x0; x <= rect.x1; ++x)
+					pixels.push_back(y * width + x);
+			computePixels(pixels.data(), pixels.size());
+			continue;
+		}
+
+		// The set is connected, so the uniform border means uniform interior (flood-fill it)
+		if (traceBorder(rect)){
+			const int value = data[rect.y0 * width + rect.x0];
+			for (int y = rect.y0 + 1; y < rect.y1; ++y)
+				std::fill(data + y * width + rect.x0 + 1, data + y * width + rect.x1, value);
+			continue;
+		}
+
+		// Otherwise split the rectangle along the longer side, the middle line is shared
+		if (w >= h){
+			const int xm = (rect.x0 + rect.x1) / 2;
+			stack.push_back({rect.x0, rect.y0, xm, rect.y1});
+			stack.push_back({xm, rect.y0, rect.x1, rect.y1});
+		} else {
+			const int ym = (rect.y0 + rect.y1) / 2;
+			stack.push_back({rect.x0, rect.y0, rect.x1, ym});
+			stack.push_back({rect.x0, ym, rect.x1, rect.y1});
+		}
+	}
+
+	// Copy the rows to next half of the image
+	if (mirror){
+		for (int i = 0; i < height / 2; ++i)
+			std::memcpy(data + (height-i-1) * width, data + (i * width), width * sizeof(int));
+	}
+	return data;
+}
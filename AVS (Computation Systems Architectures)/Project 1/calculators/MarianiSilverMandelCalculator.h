@@ -0,0 +1,67 @@
+/**
+ * @file MarianiSilverMandelCalculator.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator that traces borders of rectangles and fills uniform ones (Mariani-Silver)
+ * @date 17.10.2026
+ */
+#ifndef MARIANISILVERMANDELCALCULATOR_H
+#define MARIANISILVERMANDELCALCULATOR_H
+
+#include <BaseMandelCalculator.h>
+#include "ScratchBuffer.h"
+
+class MarianiSilverMandelCalculator : public BaseMandelCalculator
+{
+public:
+    /**
+     * @brief Construct a new Mariani Silver Mandel Calculator object
+     *
+     * @param matrixBaseSize basic size (width will be multiplied by 3, height by 2)
+     * @param limit number of iterations
+     * @param halfImage true = only the upper half is traced and mirrored (if the viewport is symmetric), false = the full image is traced
+     */
+    MarianiSilverMandelCalculator(unsigned matrixBaseSize, unsigned limit, bool halfImage = true);
+    ~MarianiSilverMandelCalculator();
+    int *calculateMandelbrot();
+
+private:
+    /**
+     * @brief Rectangle of pixels (bounds are inclusive)
+     */
+    struct Rect { int x0, y0, x1, y1; };
+
+    /**
+     * @brief Computes pixels given by their indices in data that were not computed yet (gathered, used for the
+     * vertical edges and the narrow rectangles)
+     *
+     * @param idx indices of the pixels
+     * @param count number of the pixels
+     */
+    void computePixels(const int *idx, int count);
+
+    /**
+     * @brief Computes pixels [x0, x1] of row y that were not computed yet, every run of them by the row kernel
+     */
+    void computeRowSegment(int y, int x0, int x1);
+
+    /**
+     * @brief Computes the border of the rectangle and returns true if all its pixels have the same value
+     */
+    bool traceBorder(const Rect &rect);
+
+    static const int chunkSize = 1024; // pixels passed to the kernel at once
+    static const int minRectSize = 8;  // smaller rectangles are computed pixel by pixel
+
+    const bool halfImage;
+    bool doublePrecision; // precision of the current calculation
+
+    int *data;
+    int *idxBuffer;     // indices of the pixels to compute
+    int *outBuffer;     // computed iterations
+    ScratchBuffer crBuffer;   // real parts of the pixels to compute (viewed as float* by the float kernel)
+    ScratchBuffer ciBuffer;   // imaginary parts of the pixels to compute
+    ScratchBuffer rBuffer;
+    ScratchBuffer iBuffer;
+};
+
+#endif
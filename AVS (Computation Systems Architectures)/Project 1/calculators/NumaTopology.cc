@@ -0,0 +1,186 @@
+/**
+ * @file NumaTopology.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief NUMA nodes of the machine, pinning of the OpenMP threads and placement of pages on the nodes
+ * @date 17.10.2026
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+
+#include <sched.h>	        // sched_setaffinity()
+#include <unistd.h>	        // sysconf()
+#include <sys/syscall.h>	// SYS_move_pages
+#include <omp.h>
+
+#include "NumaTopology.h"
+
+static const char *SYSFS_NODE_DIR = "/sys/devices/system/node/node";
+static const int MAX_NODES = 1024;
+
+
+/**
+ * @brief CPUs of a sysfs cpulist ("0-3,8-11")
+ */
+static std::vector<int> parseCpuList(const std::string &list)
+{
+	std::vector<int> cpus;
+	std::stringstream ss(list);
+	std::string range;
+	while (std::getline(ss, range, ',')){
+		if (range.empty()) continue;
+		try {
+			const size_t dash = range.find('-');
+			const int first = std::stoi(range.substr(0, dash));
+			const int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+			for (int cpu = first; cpu <= last; ++cpu)
+				cpus.push_back(cpu);
+		} catch (const std::exception &) {
+			continue;
+		}
+	}
+	return cpus;
+}
+
+
+NumaTopology NumaTopology::detect()
+{
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	const bool hasAffinity = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+	NumaTopology topology;
+	for (int node = 0; node < MAX_NODES; ++node){
+		std::ifstream in(SYSFS_NODE_DIR + std::to_string(node) + "/cpulist");
+		if (!in) continue;
+
+		std::string list;
+		std::getline(in, list);
+
+		// CPUs outside of the affinity mask of the process (cgroups, taskset) can not be used for pinning
+		std::vector<int> cpus;
+		for (int cpu : parseCpuList(list))
+			if (!hasAffinity || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)))
+				cpus.push_back(cpu);
+
+		if (cpus.empty()) continue;
+		topology.nodeIds.push_back(node);
+		topology.nodeCpus.push_back(cpus);
+	}
+
+	// Without the node directory all CPUs of the process form one node
+	if (topology.nodeIds.empty()){
+		std::vector<int> cpus;
+		const long count = hasAffinity ? CPU_SETSIZE : sysconf(_SC_NPROCESSORS_ONLN);
+		for (int cpu = 0; cpu < count; ++cpu)
+			if (!hasAffinity || CPU_ISSET(cpu, &allowed))
+				cpus.push_back(cpu);
+
+		topology.nodeIds.push_back(0);
+		topology.nodeCpus.push_back(cpus);
+	}
+	return topology;
+}
+
+
+std::vector<int> NumaTopology::cpuOrder(ThreadPinning pinning) const
+{
+	std::vector<int> order;
+	if (pinning == ThreadPinning::COMPACT || pinning == ThreadPinning::NONE){
+		for (const std::vector<int> &cpus : nodeCpus)
+			order.insert(order.end(), cpus.begin(), cpus.end());
+		return order;
+	}
+
+	// Scatter: k-th CPU of every node before the (k + 1)-th ones
+	size_t maxCpus = 0;
+	for (const std::vector<int> &cpus : nodeCpus)
+		maxCpus = std::max(maxCpus, cpus.size());
+
+	for (size_t k = 0; k < maxCpus; ++k)
+		for (const std::vector<int> &cpus : nodeCpus)
+			if (k < cpus.size())
+				order.push_back(cpus[k]);
+	return order;
+}
+
+
+bool NumaTopology::pinThreads(ThreadPinning pinning)
+{
+	const NumaTopology topology = detect();
+	const std::vector<int> order = topology.cpuOrder(pinning);
+	if (order.empty()) return false;
+
+	int failed = 0;
+
+	#pragma omp parallel reduction(+:failed)
+	{
+		cpu_set_t set;
+		CPU_ZERO(&set);
+
+		if (pinning == ThreadPinning::NONE){
+			// Unpinned threads may run on every CPU of the process
+			for (int cpu : order)
+				CPU_SET(cpu, &set);
+		}
+		else
+			CPU_SET(order[omp_get_thread_num() % order.size()], &set);
+
+		failed += sched_setaffinity(0, sizeof(set), &set) != 0;
+	}
+	return failed == 0;
+}
+
+
+ThreadPinning NumaTopology::parsePinning(const std::string &name)
+{
+	if (name == "none")    return ThreadPinning::NONE;
+	if (name == "compact") return ThreadPinning::COMPACT;
+	if (name == "scatter") return ThreadPinning::SCATTER;
+	throw std::invalid_argument("unknown thread pinning '" + name + "' (none, compact, scatter)");
+}
+
+std::string NumaTopology::pinningName(ThreadPinning pinning)
+{
+	switch (pinning){
+		case ThreadPinning::COMPACT: return "compact";
+		case ThreadPinning::SCATTER: return "scatter";
+		default:                     return "none";
+	}
+}
+
+
+std::vector<long> NumaTopology::bytesPerNode(const void *data, size_t bytes)
+{
+	const long pageSize = sysconf(_SC_PAGESIZE);
+	const uintptr_t first = uintptr_t(data) / pageSize * pageSize;
+	const uintptr_t end = uintptr_t(data) + bytes;
+
+	std::vector<void *> pages;
+	for (uintptr_t page = first; page < end; page += pageSize)
+		pages.push_back((void*)page);
+
+	// move_pages without target nodes only reports the node of every page (negative status = not present)
+	std::vector<int> status(pages.size(), -1);
+	if (pages.empty() || syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, status.data(), 0) != 0)
+		return std::vector<long>();
+
+	std::vector<long> perNode;
+	for (size_t p = 0; p < pages.size(); ++p){
+		const int node = status[p];
+		if (node < 0) continue;
+
+		// Only the part of the page inside the buffer is counted
+		const uintptr_t from = std::max(uintptr_t(pages[p]), uintptr_t(data));
+		const uintptr_t to = std::min(uintptr_t(pages[p]) + pageSize, end);
+		if (node >= (int)perNode.size()) perNode.resize(node + 1, 0);
+		perNode[node] += long(to - from);
+	}
+	return perNode;
+}
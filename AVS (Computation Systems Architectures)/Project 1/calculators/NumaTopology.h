@@ -0,0 +1,66 @@
+/**
+ * @file NumaTopology.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief NUMA nodes of the machine, pinning of the OpenMP threads and placement of pages on the nodes
+ * @date 17.10.2026
+ */
+#ifndef NUMATOPOLOGY_H
+#define NUMATOPOLOGY_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Placement of the OpenMP threads on the CPUs
+ *
+ * NONE     threads are not pinned (the scheduler may move them and their first-touched pages become remote)
+ * COMPACT  consecutive threads on consecutive CPUs, nodes are filled one by one
+ * SCATTER  consecutive threads on different nodes (round robin), uses the memory bandwidth of all nodes first
+ */
+enum class ThreadPinning { NONE, COMPACT, SCATTER };
+
+/**
+ * @brief NUMA nodes read from sysfs (/sys/devices/system/node), without libnuma
+ *
+ * Machines (or containers) without the node directory are reported as a single node with all CPUs of the process.
+ */
+struct NumaTopology
+{
+    std::vector<int> nodeIds;               // ids of the nodes with CPUs
+    std::vector<std::vector<int>> nodeCpus; // CPUs of each node (usable by the process)
+
+    int nodes() const { return int(nodeIds.size()); }
+
+    /**
+     * @brief Topology of this machine
+     */
+    static NumaTopology detect();
+
+    /**
+     * @brief CPU of every thread slot for the pinning (thread t uses the slot t % size)
+     */
+    std::vector<int> cpuOrder(ThreadPinning pinning) const;
+
+    /**
+     * @brief Pins the threads of the OpenMP pool (libgomp reuses them, so the pinning lasts for later regions)
+     *
+     * @return false if a thread could not be pinned
+     */
+    static bool pinThreads(ThreadPinning pinning);
+
+    /**
+     * @brief Pinning given by its name (none, compact, scatter)
+     */
+    static ThreadPinning parsePinning(const std::string &name);
+
+    static std::string pinningName(ThreadPinning pinning);
+
+    /**
+     * @brief Bytes of the buffer placed on each node (index = node id), pages that were not touched yet are not
+     * counted, empty if the placement can not be queried (move_pages)
+     */
+    static std::vector<long> bytesPerNode(const void *data, size_t bytes);
+};
+
+#endif
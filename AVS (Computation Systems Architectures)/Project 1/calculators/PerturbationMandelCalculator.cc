@@ -0,0 +1,232 @@
+/**
+ * @file PerturbationMandelCalculator.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of deep-zoom Mandelbrot calculator based on perturbation of a high-precision reference orbit
+ * @date 17.10.2026
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <stdlib.h>
+
+#include <immintrin.h>	// _mm_malloc()
+#include <cstring>	    // memcpy()
+
+#include "MandelKernels.h"
+#include "PerturbationMandelCalculator.h"
+
+// Lane states
+static const int RUNNING = 0;
+static const int ESCAPED = 1;
+static const int GLITCHED = 2;
+
+
+PerturbationMandelCalculator::PerturbationMandelCalculator (unsigned matrixBaseSize, unsigned limit) :
+	BaseMandelCalculator(matrixBaseSize, limit, "PerturbationMandelCalculator"), deepViewport(false), references(0)
+{
+	data = (int*)(_mm_malloc(height * width * sizeof(int), 64));
+	dcrBuffer = (double*)(_mm_malloc(MandelKernels::blockSize * sizeof(double), 64));
+	dciBuffer = (double*)(_mm_malloc(MandelKernels::blockSize * sizeof(double), 64));
+	drBuffer = (double*)(_mm_malloc(MandelKernels::blockSize * sizeof(double), 64));
+	diBuffer = (double*)(_mm_malloc(MandelKernels::blockSize * sizeof(double), 64));
+	outBuffer = (int*)(_mm_malloc(MandelKernels::blockSize * sizeof(int), 64));
+	stateBuffer = (int*)(_mm_malloc(MandelKernels::blockSize * sizeof(int), 64));
+}
+
+PerturbationMandelCalculator::~PerturbationMandelCalculator() {
+	_mm_free(data);
+	_mm_free(dcrBuffer);
+	_mm_free(dciBuffer);
+	_mm_free(drBuffer);
+	_mm_free(diBuffer);
+	_mm_free(outBuffer);
+	_mm_free(stateBuffer);
+	data = nullptr;
+	dcrBuffer = nullptr;
+	dciBuffer = nullptr;
+	drBuffer = nullptr;
+	diBuffer = nullptr;
+	outBuffer = nullptr;
+	stateBuffer = nullptr;
+}
+
+
+void PerturbationMandelCalculator::setDeepViewport(const std::string &centerReal, const std::string &centerImag, double scale, double aspectRatio) {
+
+	deepViewport = true;
+	this->centerReal = DoubleDouble::fromString(centerReal);
+	this->centerImag = DoubleDouble::fromString(centerImag);
+
+	// Bounds are only approximate (used by info() and symmetry test), the steps are computed from the scale directly,
+	// because the difference of the bounds loses all precision at deep zooms
+	setViewport(this->centerReal.hi, this->centerImag.hi, scale, aspectRatio);
+	dx = scale / (width - 1);
+	dy = scale * aspectRatio / (height - 1);
+}
+
+
+void PerturbationMandelCalculator::computeReferenceOrbit(double offsetReal, double offsetImag) {
+
+	const DoubleDouble cReal = centerReal + DoubleDouble(offsetReal);
+	const DoubleDouble cImag = centerImag + DoubleDouble(offsetImag);
+
+	orbitReal.clear();
+	orbitImag.clear();
+
+	DoubleDouble zReal = cReal;
+	DoubleDouble zImag = cImag;
+	for (int l = 0; l < limit; ++l){
+		orbitReal.push_back(zReal.hi);
+		orbitImag.push_back(zImag.hi);
+
+		// Orbit ends when the reference escapes, pixels that need more iterations glitch
+		if (zReal.hi * zReal.hi + zImag.hi * zImag.hi >= 4.0) break;
+
+		DoubleDouble r2 = zReal * zReal;
+		DoubleDouble i2 = zImag * zImag;
+		zImag = DoubleDouble(2.0) * zReal * zImag + cImag;
+		zReal = r2 - i2 + cReal;
+	}
+	++references;
+}
+
+
+int PerturbationMandelCalculator::iteratePending(double offsetReal, double offsetImag) {
+
+	const int blockSize = MandelKernels::blockSize;
+	const int orbitLength = orbitReal.size();
+	const double *pOrbitReal = orbitReal.data();
+	const double *pOrbitImag = orbitImag.data();
+
+	double *dcr = dcrBuffer;
+	double *dci = dciBuffer;
+	double *dr = drBuffer;
+	double *di = diBuffer;
+	int *out = outBuffer;
+	int *state = stateBuffer;
+
+	std::vector<int> glitched;
+
+	for (size_t blockStart = 0; blockStart < pending.size(); blockStart += blockSize){
+		const int n = std::min<size_t>(blockSize, pending.size() - blockStart);
+		const int *pIdx = pending.data() + blockStart;
+
+		// Delta c of the pixel is its offset from the center minus the offset of the reference (both are small)
+		for (int k = 0; k < n; ++k){
+			const int j = pIdx[k] % width;
+			const int i = pIdx[k] / width;
+			dcr[k] = (j - (width - 1) / 2.0) * dx - offsetReal;
+			dci[k] = (i - (height - 1) / 2.0) * dy - offsetImag;
+			dr[k] = dcr[k];
+			di[k] = dci[k];
+			out[k] = 0;
+			state[k] = RUNNING;
+		}
+
+		// Iterate limits for the lanes
+		for (int l = 0; l < limit; ++l){
+
+			// Reference escaped earlier than the pixels
+			if (l >= orbitLength){
+				for (int k = 0; k < n; ++k)
+					state[k] = (state[k] == RUNNING) ? GLITCHED : state[k];
+				break;
+			}
+
+			const double zr = pOrbitReal[l];
+			const double zi = pOrbitImag[l];
+			const double zMag = glitchTolerance * (zr * zr + zi * zi);
+
+			int doneCnt = 0;
+
+			#pragma omp simd reduction(+:doneCnt)
+			for (int k = 0; k < n; ++k){
+
+				const double dReal = dr[k];
+				const double dImag = di[k];
+
+				// Full value of the pixel z = Z + d
+				const double fullReal = zr + dReal;
+				const double fullImag = zi + dImag;
+				const double mag = fullReal * fullReal + fullImag * fullImag;
+
+				const int escaped = mag >= 4.0;
+				const int glitch = !escaped & (mag < zMag);
+				const int running = state[k] == RUNNING;
+				const int newState = running ? (escaped ? ESCAPED : (glitch ? GLITCHED : RUNNING)) : state[k];
+
+				const int cont = newState == RUNNING;
+				out[k] += cont;
+				doneCnt += !cont;
+
+				// d' = 2 Z d + d^2 + dc
+				const double newReal = 2.0 * (zr * dReal - zi * dImag) + (dReal * dReal - dImag * dImag) + dcr[k];
+				const double newImag = 2.0 * (zr * dImag + zi * dReal) + 2.0 * dReal * dImag + dci[k];
+
+				state[k] = newState;
+				dr[k] = cont ? newReal : dReal;
+				di[k] = cont ? newImag : dImag;
+			}
+
+			// Stop if the lanes are fully computed
+			if (doneCnt >= n) break;
+		}
+
+		// Store results, glitched pixels keep the provisional value and wait for the next reference
+		for (int k = 0; k < n; ++k){
+			data[pIdx[k]] = out[k];
+			if (state[k] == GLITCHED)
+				glitched.push_back(pIdx[k]);
+		}
+	}
+
+	pending.swap(glitched);
+	return pending.size();
+}
+
+
+int * PerturbationMandelCalculator::calculateMandelbrot () {
+
+	// Without deep viewport the center follows the (double precision) viewport of the base class
+	if (!deepViewport){
+		centerReal = DoubleDouble((x_start + x_fin) / 2.0);
+		centerImag = DoubleDouble((y_start + y_fin) / 2.0);
+	}
+
+	// Due to symmetricity just half of the rows is computed (if the center lies on the real axis)
+	const bool symmetric = isSymmetric();
+	const int rows = symmetric ? height / 2 : height;
+
+	pending.resize(rows * width);
+	for (int p = 0; p < rows * width; ++p)
+		pending[p] = p;
+
+	// The first reference is the center of the viewport
+	references = 0;
+	double offsetReal = 0.0;
+	double offsetImag = 0.0;
+	computeReferenceOrbit(offsetReal, offsetImag);
+
+	while (iteratePending(offsetReal, offsetImag) > 0 && references < maxReferences){
+
+		// New reference is the glitched pixel with the most iterations (the deepest part of the glitch)
+		int best = pending[0];
+		for (int p : pending){
+			if (data[p] > data[best]) best = p;
+		}
+		offsetReal = ((best % width) - (width - 1) / 2.0) * dx;
+		offsetImag = ((best / width) - (height - 1) / 2.0) * dy;
+		computeReferenceOrbit(offsetReal, offsetImag);
+	}
+	pending.clear();
+
+	// Copy the rows to next half of the image
+	if (symmetric){
+		for (int i = 0; i < height / 2; ++i)
+			std::memcpy(data + (height-i-1) * width, data + (i * width), width * sizeof(int));
+	}
+	return data;
+}
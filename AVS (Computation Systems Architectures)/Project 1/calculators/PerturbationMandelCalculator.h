@@ -0,0 +1,77 @@
+/**
+ * @file PerturbationMandelCalculator.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of deep-zoom Mandelbrot calculator based on perturbation of a high-precision reference orbit
+ * @date 17.10.2026
+ */
+#ifndef PERTURBATIONMANDELCALCULATOR_H
+#define PERTURBATIONMANDELCALCULATOR_H
+
+#include <string>
+#include <vector>
+
+#include <BaseMandelCalculator.h>
+#include "DoubleDouble.h"
+
+class PerturbationMandelCalculator : public BaseMandelCalculator
+{
+public:
+    PerturbationMandelCalculator(unsigned matrixBaseSize, unsigned limit);
+    ~PerturbationMandelCalculator();
+    int *calculateMandelbrot();
+
+    /**
+     * @brief Sets viewport with the center given in full (double-double) precision
+     *
+     * @param centerReal decimal real value of the center (e.g. "-0.743643887037158704752191506114774")
+     * @param centerImag decimal imag value of the center
+     * @param scale width of the viewport (range of real values), can be far below double precision of the center
+     * @param aspectRatio height of the viewport divided by its width
+     */
+    void setDeepViewport(const std::string &centerReal, const std::string &centerImag, double scale, double aspectRatio = 1.0);
+
+    /**
+     * @brief Number of reference orbits used by the last calculation (1 = no glitches)
+     */
+    int referenceCount() const { return references; }
+
+private:
+    /**
+     * @brief Computes orbit of the reference point in double-double precision, stores it rounded to double
+     *
+     * @param offsetReal offset of the reference point from the center (real)
+     * @param offsetImag offset of the reference point from the center (imag)
+     */
+    void computeReferenceOrbit(double offsetReal, double offsetImag);
+
+    /**
+     * @brief Iterates deltas of the pending pixels against the current reference orbit
+     *
+     * @param offsetReal offset of the reference point from the center (real)
+     * @param offsetImag offset of the reference point from the center (imag)
+     * @return number of pixels that glitched (they stay in the pending list)
+     */
+    int iteratePending(double offsetReal, double offsetImag);
+
+    static const int maxReferences = 32;      // glitched pixels that remain after this many references keep their value
+    static constexpr double glitchTolerance = 1e-6; // |Z + d|^2 < tolerance * |Z|^2 means lost precision (Pauldelbrot)
+
+    bool deepViewport; // center was set by setDeepViewport(), otherwise it follows the base viewport
+    DoubleDouble centerReal;
+    DoubleDouble centerImag;
+    int references;
+
+    int *data;
+    std::vector<double> orbitReal; // reference orbit Z_n (rounded to double)
+    std::vector<double> orbitImag;
+    std::vector<int> pending;      // indices of the pixels to (re)compute
+
+    double *dcrBuffer; // SoA lanes: delta c (real)
+    double *dciBuffer; // delta c (imag)
+    double *drBuffer;  // delta z (real)
+    double *diBuffer;  // delta z (imag)
+    int *outBuffer;    // number of iterations
+    int *stateBuffer;  // lane state (running, escaped, glitched)
+};
+
+#endif
@@ -0,0 +1,180 @@
+/**
+ * @file ProgressiveMandelCalculator.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator that renders coarse-to-fine passes and reports finished tiles
+ * @date 17.10.2026
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include <stdlib.h>
+
+#include <immintrin.h>	// _mm_malloc()
+#include <cstring>	    // memcpy()
+#include <omp.h>
+
+#include "MandelKernels.h"
+#include "ProgressiveMandelCalculator.h"
+
+
+ProgressiveMandelCalculator::ProgressiveMandelCalculator (unsigned matrixBaseSize, unsigned limit, int coarseStep) :
+	BaseMandelCalculator(matrixBaseSize, limit, "ProgressiveMandelCalculator"), coarseStep(coarseStep), perTile(true)
+{
+	formulasSupported = true;
+	// Tiles have to be aligned to the grid of every pass
+	if (coarseStep < 1 || coarseStep > tileSize || (coarseStep & (coarseStep - 1)) != 0)
+		throw std::invalid_argument("ProgressiveMandelCalculator: coarse step has to be a power of two up to " + std::to_string(tileSize));
+
+	data = (int*)(_mm_malloc(height * width * sizeof(int), 64));
+
+	threads = omp_get_max_threads();
+	for (int t = 0; t < threads; ++t){
+		idxBuffers.push_back((int*)(_mm_malloc(tileSize * tileSize * sizeof(int), 64)));
+		outBuffers.push_back((int*)(_mm_malloc(tileSize * tileSize * sizeof(int), 64)));
+		crBuffers.emplace_back(tileSize * tileSize);
+		ciBuffers.emplace_back(tileSize * tileSize);
+		rBuffers.emplace_back(MandelKernels::blockSize);
+		iBuffers.emplace_back(MandelKernels::blockSize);
+	}
+
+	tilesX = (width + tileSize - 1) / tileSize;
+	cVariant = "step" + std::to_string(coarseStep);
+}
+
+ProgressiveMandelCalculator::~ProgressiveMandelCalculator() {
+	_mm_free(data);
+	data = nullptr;
+	for (int t = 0; t < threads; ++t){
+		_mm_free(idxBuffers[t]);
+		_mm_free(outBuffers[t]);
+	}
+	idxBuffers.clear();
+	outBuffers.clear();
+}
+
+
+void ProgressiveMandelCalculator::setProgressCallback(ProgressCallback callback, bool perTile) {
+	this->callback = callback;
+	this->perTile = perTile;
+}
+
+
+int * ProgressiveMandelCalculator::calculateMandelbrot () {
+
+	// Float kernels are used while the pixel spacing allows it
+	return needsDoublePrecision() ? dispatch<double>() : dispatch<float>();
+}
+
+
+template <typename T>
+int * ProgressiveMandelCalculator::dispatch () {
+
+	switch (formula.kind){
+		case FractalFormula::MULTIBROT3:   return calculate<T>(Formulas::Multibrot<3>());
+		case FractalFormula::MULTIBROT4:   return calculate<T>(Formulas::Multibrot<4>());
+		case FractalFormula::JULIA:        return calculate<T>(formula.juliaPolicy());
+		case FractalFormula::BURNING_SHIP: return calculate<T>(Formulas::BurningShip());
+		default:                           return calculate<T>(Formulas::Mandelbrot());
+	}
+}
+
+
+template <typename T, class Formula>
+void ProgressiveMandelCalculator::calculateTile(int tile, int rows, int step, bool last, int thread, const Formula &f) {
+
+	const int rowStart = (tile / tilesX) * tileSize;
+	const int rowEnd = std::min(rowStart + tileSize, rows);
+	const int colStart = (tile % tilesX) * tileSize;
+	const int colEnd = std::min(colStart + tileSize, width);
+	const bool first = step == coarseStep;
+
+	int *idx = idxBuffers[thread];
+	int *out = outBuffers[thread];
+	T *cr = crBuffers[thread].as<T>();
+	T *ci = ciBuffers[thread].as<T>();
+
+	// Pixels new in this pass lie on its grid, but not on the grid of the previous pass (computed already)
+	int count = 0;
+	for (int i = rowStart; i < rowEnd; i += step){
+		const bool previousRow = (i % (2 * step)) == 0;
+		for (int j = colStart; j < colEnd; j += step){
+			if (!first && previousRow && (j % (2 * step)) == 0) continue;
+
+			idx[count] = i * width + j;
+			cr[count] = x_start + j * dx;
+			ci[count] = y_start + i * dy;
+			++count;
+		}
+	}
+
+	MandelKernels::points(cr, ci, out, count, limit, rBuffers[thread].as<T>(), iBuffers[thread].as<T>(), f);
+
+	for (int k = 0; k < count; ++k)
+		data[idx[k]] = out[k];
+
+	// Preview: pixels that are not computed yet take the value of the computed pixel of their step x step block
+	if (!last){
+		for (int i = rowStart; i < rowEnd; ++i){
+			int *pdata = data + i * width;
+			const int *pblock = data + (i - i % step) * width;
+			for (int j = colStart; j < colEnd; ++j)
+				pdata[j] = pblock[j - j % step];
+		}
+	}
+}
+
+
+template <typename T, class Formula>
+int * ProgressiveMandelCalculator::calculate (const Formula &f) {
+
+	// Due to symmetricity just half of the rows is computed, the rest is mirrored by the tiles
+	const bool symmetric = isSymmetric();
+	const int rows = symmetric ? height / 2 : height;
+	const int tiles = tilesX * ((rows + tileSize - 1) / tileSize);
+
+	int passes = 0;
+	for (int step = coarseStep; step >= 1; step /= 2) ++passes;
+
+	// Every pixel is computed in exactly one pass, so all passes together do the work of one full render
+	int pass = 0;
+	for (int step = coarseStep; step >= 1; step /= 2, ++pass){
+		const bool last = step == 1;
+
+		#pragma omp parallel num_threads(threads)
+		{
+			const int thread = omp_get_thread_num();
+
+			#pragma omp for schedule(dynamic, 1)
+			for (int tile = 0; tile < tiles; ++tile){
+				calculateTile<T>(tile, rows, step, last, thread, f);
+
+				const int rowStart = (tile / tilesX) * tileSize;
+				const int rowEnd = std::min(rowStart + tileSize, rows);
+				const int colStart = (tile % tilesX) * tileSize;
+				const int colEnd = std::min(colStart + tileSize, width);
+
+				// Copy the rows of the tile to next half of the image
+				if (symmetric){
+					for (int i = rowStart; i < rowEnd; ++i)
+						std::memcpy(data + (height-i-1) * width + colStart, data + i * width + colStart, (colEnd - colStart) * sizeof(int));
+				}
+
+				if (callback && perTile){
+					ProgressInfo info = {pass, passes, step, rowStart, rowEnd, colStart, colEnd, symmetric, false, data};
+					#pragma omp critical(progressCallback)
+					callback(info);
+				}
+			}
+		}
+
+		if (callback){
+			ProgressInfo info = {pass, passes, step, 0, height, 0, width, false, true, data};
+			callback(info);
+		}
+	}
+	return data;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file ProgressiveMandelCalculator.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator that renders coarse-to-fine passes and reports finished tiles
+ * @date 17.10.2026
+ */
+#ifndef PROGRESSIVEMANDELCALCULATOR_H
+#define PROGRESSIVEMANDELCALCULATOR_H
+
+#include <vector>
+#include <functional>
+
+#include <BaseMandelCalculator.h>
+#include "ScratchBuffer.h"
+
+/**
+ * @brief Part of the image finished by a pass (passed to the progress callback)
+ */
+struct ProgressInfo
+{
+    int pass;     // index of the pass (0 = the coarsest)
+    int passes;   // number of passes
+    int step;     // every step-th pixel of the rows and columns is computed after this pass
+    int rowStart; // finished rectangle [rowStart, rowEnd) x [colStart, colEnd) (whole image for passDone)
+    int rowEnd;
+    int colStart;
+    int colEnd;
+    bool mirrored; // the rectangle is also mirrored to rows (height - 1 - row)
+    bool passDone; // whole pass is finished
+    const int *data;
+};
+
+class ProgressiveMandelCalculator : public BaseMandelCalculator
+{
+public:
+    using ProgressCallback = std::function<void(const ProgressInfo &)>;
+
+    /**
+     * @brief Construct a new Progressive Mandel Calculator object
+     *
+     * @param matrixBaseSize basic size (width will be multiplied by 3, height by 2)
+     * @param limit number of iterations
+     * @param coarseStep pixel step of the first pass (power of two), every next pass halves it
+     */
+    ProgressiveMandelCalculator(unsigned matrixBaseSize, unsigned limit, int coarseStep = 8);
+    ~ProgressiveMandelCalculator();
+    int *calculateMandelbrot();
+
+    /**
+     * @brief Sets the callback called after every finished tile (if perTile) and after every pass
+     *
+     * Tiles are computed in parallel, the callback is called from the worker threads, but never concurrently.
+     * Pixels that are not computed yet hold the value of the nearest computed pixel above-left of them.
+     */
+    void setProgressCallback(ProgressCallback callback, bool perTile = true);
+
+private:
+    template <typename T>
+    int *dispatch();
+
+    template <typename T, class Formula>
+    int *calculate(const Formula &f);
+
+    /**
+     * @brief Computes pixels of the tile that are new in the pass and fills the rest of the tile from them
+     */
+    template <typename T, class Formula>
+    void calculateTile(int tile, int rows, int step, bool last, int thread, const Formula &f);
+
+    static const int tileSize = 64; // tile is tileSize x tileSize pixels (multiple of the coarsest step)
+
+    const int coarseStep;
+    ProgressCallback callback;
+    bool perTile;
+
+    int *data;
+    int threads;
+    int tilesX;
+    // Per-thread buffers of the pixels computed in a tile (tileSize^2 elements, allocated for double)
+    std::vector<int *> idxBuffers;
+    std::vector<int *> outBuffers;
+    std::vector<ScratchBuffer> crBuffers;
+    std::vector<ScratchBuffer> ciBuffers;
+    std::vector<ScratchBuffer> rBuffers;
+    std::vector<ScratchBuffer> iBuffers;
+};
+
+#endif
@@ -9,11 +9,14 @@
 #include <vector>
 #include <algorithm>
 
+#include "FpContract.h"
 #include "RefMandelCalculator.h"
 
 RefMandelCalculator::RefMandelCalculator(unsigned matrixBaseSize, unsigned limit) : BaseMandelCalculator(matrixBaseSize, limit, "RefMandelCalculator")
 {
 	data = (int *)(malloc(height * width * sizeof(int)));
+	shortcutsSupported = true;
+	formulasSupported = true;
 }
 
 RefMandelCalculator::~RefMandelCalculator()
@@ -22,12 +25,37 @@ RefMandelCalculator::~RefMandelCalculator()
 	data = NULL;
 }
 
+template <typename T, class Formula>
+static inline int escapeTime(const Formula &formula, T real, T imag, int limit)
+{
+	const T bailout = formula.bailout();
+
+	T zReal = real;
+	T zImag = imag;
+
+	for (int i = 0; i < limit; ++i)
+	{
+		if (zReal * zReal + zImag * zImag > bailout)
+			return i;
+
+		formula.step(zReal, zImag, real, imag);
+	}
+	return limit;
+}
+
 template <typename T>
-static inline int mandelbrot(T real, T imag, int limit)
+static inline int mandelbrotShortcuts(T real, T imag, int limit, bool bulbTest, bool periodicityTest)
 {
+	if (bulbTest && BaseMandelCalculator::isInsideBulb(real, imag))
+		return limit;
+
 	T zReal = real;
 	T zImag = imag;
 
+	// Saved point of the orbit, it moves at powers of two (Brent)
+	T sReal = real;
+	T sImag = imag;
+
 	for (int i = 0; i < limit; ++i)
 	{
 		T r2 = zReal * zReal;
@@ -38,21 +66,55 @@ static inline int mandelbrot(T real, T imag, int limit)
 
 		zImag = 2.0f * zReal * zImag + imag;
 		zReal = r2 - i2 + real;
+
+		// The orbit is periodic, so it never escapes
+		if (periodicityTest && zReal == sReal && zImag == sImag)
+			return limit;
+
+		if ((i & (i - 1)) == 0)
+		{
+			sReal = zReal;
+			sImag = zImag;
+		}
 	}
 	return limit;
 }
 
 int *RefMandelCalculator::calculateMandelbrot()
 {
+	// Float is used while the pixel spacing allows it
+	return needsDoublePrecision() ? dispatch<double>() : dispatch<float>();
+}
+
+template <typename T>
+int *RefMandelCalculator::dispatch()
+{
+	switch (formula.kind)
+	{
+	case FractalFormula::MULTIBROT3:   return calculate<T>(Formulas::Multibrot<3>());
+	case FractalFormula::MULTIBROT4:   return calculate<T>(Formulas::Multibrot<4>());
+	case FractalFormula::JULIA:        return calculate<T>(formula.juliaPolicy());
+	case FractalFormula::BURNING_SHIP: return calculate<T>(Formulas::BurningShip());
+	default:                           return calculate<T>(Formulas::Mandelbrot());
+	}
+}
+
+template <typename T, class Formula>
+int *RefMandelCalculator::calculate(const Formula &f)
+{
+	// Shortcuts are valid only for the Mandelbrot set
+	const bool shortcuts = (bulbTest || periodicityTest) && formula.kind == FractalFormula::MANDELBROT;
+
 	int *pdata = data;
 	for (int i = 0; i < height; i++)
 	{
 		for (int j = 0; j < width; j++)
 		{
-			float x = x_start + j * dx; // current real value
-			float y = y_start + i * dy; // current imaginary value
+			T x = x_start + j * dx; // current real value
+			T y = y_start + i * dy; // current imaginary value
 
-			int value = mandelbrot(x, y, limit);
+			int value = shortcuts ? mandelbrotShortcuts(x, y, limit, bulbTest, periodicityTest)
+								  : escapeTime(f, x, y, limit);
 
 			*(pdata++) = value;
 		}
@@ -18,6 +18,15 @@ public:
     int *calculateMandelbrot();
 
 private:
+    /**
+     * @brief Selects the kernel instantiated for the formula
+     */
+    template <typename T>
+    int *dispatch();
+
+    template <typename T, class Formula>
+    int *calculate(const Formula &f);
+
     int *data;
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,141 @@
+/**
+ * @file RefillMandelCalculator.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator that refills escaped SIMD lanes from a queue of pending pixels
+ * @date 17.10.2026
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <stdlib.h>
+
+#include <immintrin.h>	// _mm_malloc()
+#include <cstring>	    // memcpy()
+
+#include "FpContract.h"
+#include "RefillMandelCalculator.h"
+
+
+RefillMandelCalculator::RefillMandelCalculator (unsigned matrixBaseSize, unsigned limit) :
+	BaseMandelCalculator(matrixBaseSize, limit, "RefillMandelCalculator")
+{
+	data = (int*)(_mm_malloc(height * width * sizeof(int), 64));
+	crBuffer = ScratchBuffer(lanes);
+	ciBuffer = ScratchBuffer(lanes);
+	rBuffer = ScratchBuffer(lanes);
+	iBuffer = ScratchBuffer(lanes);
+	cntBuffer = (int*)(_mm_malloc(lanes * sizeof(int), 64));
+	idxBuffer = (int*)(_mm_malloc(lanes * sizeof(int), 64));
+	doneBuffer = (int*)(_mm_malloc(lanes * sizeof(int), 64));
+}
+
+RefillMandelCalculator::~RefillMandelCalculator() {
+	_mm_free(data);
+	_mm_free(cntBuffer);
+	_mm_free(idxBuffer);
+	_mm_free(doneBuffer);
+	data = nullptr;
+	cntBuffer = nullptr;
+	idxBuffer = nullptr;
+	doneBuffer = nullptr;
+}
+
+
+int * RefillMandelCalculator::calculateMandelbrot () {
+
+	// Float kernel is used while the pixel spacing allows it
+	return needsDoublePrecision() ? calculate<double>() : calculate<float>();
+}
+
+
+template <typename T>
+int * RefillMandelCalculator::calculate () {
+
+	T *cr = crBuffer.as<T>();
+	T *ci = ciBuffer.as<T>();
+	T *rBuf = rBuffer.as<T>();
+	T *iBuf = iBuffer.as<T>();
+	int *cnt = cntBuffer;
+	int *idx = idxBuffer;
+	int *done = doneBuffer;
+	const int lim = limit;
+
+	// Queue of pending pixels is the (half) image in row-major order, next is its head
+	const bool symmetric = isSymmetric();
+	const int pixels = (symmetric ? height / 2 : height) * width;
+	int next = 0;
+
+	// Stores results of the finished lanes and loads next pixels into them, returns number of running lanes
+	auto refill = [&]() {
+		int running = 0;
+		for (int k = 0; k < lanes; ++k){
+			if (done[k]){
+				if (idx[k] >= 0)
+					data[idx[k]] = cnt[k];
+
+				if (next < pixels){
+					const int p = next++;
+					idx[k] = p;
+					cr[k] = x_start + (p % width) * dx;
+					ci[k] = y_start + (p / width) * dy;
+					rBuf[k] = cr[k];
+					iBuf[k] = ci[k];
+					cnt[k] = 0;
+					done[k] = 0;
+				} else {
+					idx[k] = -1;
+				}
+			}
+			running += !done[k];
+		}
+		return running;
+	};
+
+	for (int k = 0; k < lanes; ++k){
+		idx[k] = -1;
+		done[k] = 1;
+	}
+
+	while (refill() > 0){
+
+		// Lanes are refilled once enough of them finished, the last pixels are drained completely
+		const int target = (next < pixels) ? refillThreshold : lanes;
+		int doneCnt = 0;
+
+		while (doneCnt < target){
+			doneCnt = 0;
+
+			// Iterate lanes (every lane has its own pixel and iteration count)
+			#pragma omp simd reduction(+:doneCnt)
+			for (int k = 0; k < lanes; ++k){
+
+				T zReal = rBuf[k];
+				T zImag = iBuf[k];
+
+				// Calculate limit
+				T r2 = zReal * zReal;
+				T i2 = zImag * zImag;
+
+				// Lane is finished if it escaped or reached the limit
+				int finished = done[k] | ((r2 + i2) >= 4.0f) | (cnt[k] >= lim);
+				cnt[k] += !finished;
+				done[k] = finished;
+				doneCnt += finished;
+
+				// Update values in buffers
+				rBuf[k] = finished ? zReal : (r2 - i2 + cr[k]);
+				iBuf[k] = finished ? zImag : (2.0f * zReal * zImag + ci[k]);
+			}
+		}
+	}
+
+	// Copy the rows to next half of the image
+	if (symmetric){
+		for (int i = 0; i < height / 2; ++i)
+			std::memcpy(data + (height-i-1) * width, data + (i * width), width * sizeof(int));
+	}
+	return data;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file RefillMandelCalculator.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator that refills escaped SIMD lanes from a queue of pending pixels
+ * @date 17.10.2026
+ */
+#ifndef REFILLMANDELCALCULATOR_H
+#define REFILLMANDELCALCULATOR_H
+
+#include <BaseMandelCalculator.h>
+#include "ScratchBuffer.h"
+
+class RefillMandelCalculator : public BaseMandelCalculator
+{
+public:
+    RefillMandelCalculator(unsigned matrixBaseSize, unsigned limit);
+    ~RefillMandelCalculator();
+    int *calculateMandelbrot();
+
+private:
+    template <typename T>
+    int *calculate();
+
+    static const int lanes = 64;         // number of lanes (the same as batch size in BatchMandelCalculator)
+    static const int refillThreshold = 8; // lanes are refilled once at least this many of them are finished
+
+    int *data;
+    // Lanes (SoA), allocated for double and used as T* by the kernel
+    ScratchBuffer crBuffer;
+    ScratchBuffer ciBuffer;
+    ScratchBuffer rBuffer;
+    ScratchBuffer iBuffer;
+    int *cntBuffer;  // iterations of the pixel in the lane
+    int *idxBuffer;  // index of the pixel in the lane (-1 = empty lane)
+    int *doneBuffer; // 1 = lane escaped / reached limit / is empty
+};
+
+#endif
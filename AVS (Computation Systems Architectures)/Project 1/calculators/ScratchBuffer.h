@@ -0,0 +1,61 @@
+/**
+ * @file ScratchBuffer.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Aligned scratch memory of the kernels that run in float or double precision
+ * @date 17.10.2026
+ */
+#ifndef SCRATCHBUFFER_H
+#define SCRATCHBUFFER_H
+
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include <immintrin.h>	// _mm_malloc()
+
+/**
+ * @brief Untyped 64 B aligned storage for the given number of doubles, the precision selected for the frame
+ * views it as T* (the memory has no type of its own, so float and double frames may reuse it)
+ */
+class ScratchBuffer
+{
+public:
+    ScratchBuffer() = default;
+
+    explicit ScratchBuffer(size_t elements) : memory(_mm_malloc(elements * sizeof(double), 64)) {}
+
+    ScratchBuffer(ScratchBuffer &&other) noexcept : memory(other.memory)
+    {
+        other.memory = nullptr;
+    }
+
+    ScratchBuffer &operator=(ScratchBuffer &&other) noexcept
+    {
+        std::swap(memory, other.memory);
+        return *this;
+    }
+
+    ScratchBuffer(const ScratchBuffer &) = delete;
+    ScratchBuffer &operator=(const ScratchBuffer &) = delete;
+
+    ~ScratchBuffer()
+    {
+        _mm_free(memory);
+    }
+
+    /**
+     * @brief The buffer as an array of T (float or double)
+     */
+    template <typename T>
+    T *as() const
+    {
+        static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value,
+                      "scratch buffers hold float or double elements");
+        return static_cast<T*>(memory);
+    }
+
+private:
+    void *memory = nullptr;
+};
+
+#endif
@@ -0,0 +1,214 @@
+/**
+ * @file SimdMandelCalculator.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator with hand-written SSE4/AVX2/AVX-512 kernels selected at runtime
+ * @date 17.10.2026
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <stdlib.h>
+
+#include <immintrin.h>	// intrinsics, _mm_malloc()
+#include <cstring>	    // memcpy()
+
+#include "MandelKernels.h"
+#include "SimdMandelCalculator.h"
+
+// Widest vector (AVX-512 = 16 floats), the x buffer is padded to its multiple
+static const int MAX_LANES = 16;
+
+
+/**
+ * @brief AVX-512 kernel, the tail of the row is handled by masked lanes
+ */
+__attribute__((target("avx512f")))
+static void rowAvx512(int *pdata, const float *xBuffer, float y, int width, int limit)
+{
+	const __m512 four = _mm512_set1_ps(4.0f);
+	const __m512 two = _mm512_set1_ps(2.0f);
+	const __m512i one = _mm512_set1_epi32(1);
+	const __m512 ci = _mm512_set1_ps(y);
+
+	for (int j = 0; j < width; j += 16){
+		const __mmask16 valid = (width - j >= 16) ? __mmask16(0xFFFF) : __mmask16((1u << (width - j)) - 1);
+
+		const __m512 cr = _mm512_load_ps(xBuffer + j);
+		__m512 zReal = cr;
+		__m512 zImag = ci;
+		__m512i cnt = _mm512_setzero_si512();
+		__mmask16 active = valid;
+
+		for (int l = 0; l < limit; ++l){
+			__m512 r2 = _mm512_mul_ps(zReal, zReal);
+			__m512 i2 = _mm512_mul_ps(zImag, zImag);
+
+			// Lanes that escaped once stay disabled
+			active = _mm512_mask_cmp_ps_mask(active, _mm512_add_ps(r2, i2), four, _CMP_LT_OQ);
+			if (!active) break;
+
+			cnt = _mm512_mask_add_epi32(cnt, active, cnt, one);
+			zImag = _mm512_add_ps(_mm512_mul_ps(_mm512_mul_ps(two, zReal), zImag), ci);
+			zReal = _mm512_add_ps(_mm512_sub_ps(r2, i2), cr);
+		}
+		_mm512_mask_storeu_epi32(pdata + j, valid, cnt);
+	}
+}
+
+/**
+ * @brief AVX2 kernel, the tail of the row is computed in full vector and copied out
+ */
+__attribute__((target("avx2")))
+static void rowAvx2(int *pdata, const float *xBuffer, float y, int width, int limit)
+{
+	const __m256 four = _mm256_set1_ps(4.0f);
+	const __m256 two = _mm256_set1_ps(2.0f);
+	const __m256 ci = _mm256_set1_ps(y);
+	alignas(32) int tail[8];
+
+	for (int j = 0; j < width; j += 8){
+		const __m256 cr = _mm256_load_ps(xBuffer + j);
+		__m256 zReal = cr;
+		__m256 zImag = ci;
+		__m256i cnt = _mm256_setzero_si256();
+		__m256 active = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+		for (int l = 0; l < limit; ++l){
+			__m256 r2 = _mm256_mul_ps(zReal, zReal);
+			__m256 i2 = _mm256_mul_ps(zImag, zImag);
+
+			active = _mm256_and_ps(active, _mm256_cmp_ps(_mm256_add_ps(r2, i2), four, _CMP_LT_OQ));
+			if (_mm256_testz_ps(active, active)) break;
+
+			// Active lane is all ones (-1), so subtraction increments the counter
+			cnt = _mm256_sub_epi32(cnt, _mm256_castps_si256(active));
+			zImag = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(two, zReal), zImag), ci);
+			zReal = _mm256_add_ps(_mm256_sub_ps(r2, i2), cr);
+		}
+
+		if (width - j >= 8){
+			_mm256_storeu_si256((__m256i *)(pdata + j), cnt);
+		} else {
+			_mm256_store_si256((__m256i *)tail, cnt);
+			std::memcpy(pdata + j, tail, (width - j) * sizeof(int));
+		}
+	}
+}
+
+/**
+ * @brief SSE4 kernel, the tail of the row is computed in full vector and copied out
+ */
+__attribute__((target("sse4.1")))
+static void rowSse4(int *pdata, const float *xBuffer, float y, int width, int limit)
+{
+	const __m128 four = _mm_set1_ps(4.0f);
+	const __m128 two = _mm_set1_ps(2.0f);
+	const __m128 ci = _mm_set1_ps(y);
+	alignas(16) int tail[4];
+
+	for (int j = 0; j < width; j += 4){
+		const __m128 cr = _mm_load_ps(xBuffer + j);
+		__m128 zReal = cr;
+		__m128 zImag = ci;
+		__m128i cnt = _mm_setzero_si128();
+		__m128 active = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+		for (int l = 0; l < limit; ++l){
+			__m128 r2 = _mm_mul_ps(zReal, zReal);
+			__m128 i2 = _mm_mul_ps(zImag, zImag);
+
+			active = _mm_and_ps(active, _mm_cmplt_ps(_mm_add_ps(r2, i2), four));
+			if (!_mm_movemask_ps(active)) break;
+
+			cnt = _mm_sub_epi32(cnt, _mm_castps_si128(active));
+			zImag = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(two, zReal), zImag), ci);
+			zReal = _mm_add_ps(_mm_sub_ps(r2, i2), cr);
+		}
+
+		if (width - j >= 4){
+			_mm_storeu_si128((__m128i *)(pdata + j), cnt);
+		} else {
+			_mm_store_si128((__m128i *)tail, cnt);
+			std::memcpy(pdata + j, tail, (width - j) * sizeof(int));
+		}
+	}
+}
+
+
+SimdMandelCalculator::Isa SimdMandelCalculator::detectIsa()
+{
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+		return Isa::AVX512;
+	if (__builtin_cpu_supports("avx2"))
+		return Isa::AVX2;
+	if (__builtin_cpu_supports("sse4.1"))
+		return Isa::SSE4;
+	return Isa::PORTABLE;
+}
+
+const char *SimdMandelCalculator::isaName(Isa isa)
+{
+	switch (isa){
+		case Isa::AVX512: return "AVX-512";
+		case Isa::AVX2:   return "AVX2";
+		case Isa::SSE4:   return "SSE4";
+		default:          return "portable";
+	}
+}
+
+
+SimdMandelCalculator::SimdMandelCalculator (unsigned matrixBaseSize, unsigned limit) :
+	BaseMandelCalculator(matrixBaseSize, limit, "SimdMandelCalculator"), isa(detectIsa()),
+	rBuffer(MandelKernels::blockSize), iBuffer(MandelKernels::blockSize)
+{
+	cVariant = isaName(isa);
+
+	const int paddedWidth = (width + MAX_LANES - 1) / MAX_LANES * MAX_LANES;
+	data = (int*)(_mm_malloc(height * width * sizeof(int), 64));
+	xBuffer = (float*)(_mm_malloc(paddedWidth * sizeof(float), 64));
+}
+
+SimdMandelCalculator::~SimdMandelCalculator() {
+	_mm_free(data);
+	_mm_free(xBuffer);
+	data = nullptr;
+	xBuffer = nullptr;
+}
+
+
+int * SimdMandelCalculator::calculateMandelbrot () {
+
+	// Hand-written kernels are float only, deep zooms use the portable double precision kernel
+	const bool doublePrecision = needsDoublePrecision();
+
+	// Real values are the same for every row, the padding continues the sequence
+	const int paddedWidth = (width + MAX_LANES - 1) / MAX_LANES * MAX_LANES;
+	for (int j = 0; j < paddedWidth; ++j)
+		xBuffer[j] = x_start + j * dx;
+
+	// Iterate rows (due to symmetricity just half of the rows, the second half will be mem-copied)
+	const bool symmetric = isSymmetric();
+	const int rows = symmetric ? height / 2 : height;
+	for (int i = 0; i < rows; ++i){
+		int *pdata = data + width * i;
+		float y = y_start + i * dy; // current imaginary value
+
+		if (doublePrecision){
+			MandelKernels::row(pdata, 0, width, x_start, dx, y_start + i * dy, limit, rBuffer.as<double>(), iBuffer.as<double>());
+		} else switch (isa){
+			case Isa::AVX512: rowAvx512(pdata, xBuffer, y, width, limit); break;
+			case Isa::AVX2:   rowAvx2(pdata, xBuffer, y, width, limit); break;
+			case Isa::SSE4:   rowSse4(pdata, xBuffer, y, width, limit); break;
+			default:          MandelKernels::row(pdata, 0, width, x_start, dx, y, limit, rBuffer.as<float>(), iBuffer.as<float>()); break;
+		}
+
+		// Copy the row to next half of the image
+		if (symmetric)
+			std::memcpy(data + (height-i-1) * width, data + (i * width), width * sizeof(int));
+	}
+	return data;
+}
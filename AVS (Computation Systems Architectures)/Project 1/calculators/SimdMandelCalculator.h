@@ -0,0 +1,43 @@
+/**
+ * @file SimdMandelCalculator.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator with hand-written SSE4/AVX2/AVX-512 kernels selected at runtime
+ * @date 17.10.2026
+ */
+#ifndef SIMDMANDELCALCULATOR_H
+#define SIMDMANDELCALCULATOR_H
+
+#include <BaseMandelCalculator.h>
+#include "ScratchBuffer.h"
+
+class SimdMandelCalculator : public BaseMandelCalculator
+{
+public:
+    /**
+     * @brief Instruction set used by the kernel (PORTABLE = MandelKernels::row compiled for the target of the build)
+     */
+    enum class Isa { PORTABLE, SSE4, AVX2, AVX512 };
+
+    SimdMandelCalculator(unsigned matrixBaseSize, unsigned limit);
+    ~SimdMandelCalculator();
+    int *calculateMandelbrot();
+
+    /**
+     * @brief Detects the widest supported instruction set (cpuid), PORTABLE if the CPU has not even SSE4.1
+     */
+    static Isa detectIsa();
+
+    /**
+     * @brief Returns printable name of the instruction set
+     */
+    static const char *isaName(Isa isa);
+
+private:
+    Isa isa;
+    int *data;
+    float *xBuffer; // real values of the columns (padded to the widest vector)
+    ScratchBuffer rBuffer; // scratch buffers of the portable kernel, viewed as T* of the precision of the frame
+    ScratchBuffer iBuffer;
+};
+
+#endif
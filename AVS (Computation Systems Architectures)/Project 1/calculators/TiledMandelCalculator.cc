@@ -0,0 +1,214 @@
+/**
+ * @file TiledMandelCalculator.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator that computes L2 sized tiles of batches in parallel (OpenMP)
+ * @date 17.10.2026
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <numeric>	// std::gcd()
+#include <stdexcept>
+
+#include <stdlib.h>
+#include <unistd.h>	    // sysconf()
+
+#include <immintrin.h>	// _mm_malloc()
+#include <cstring>	    // memcpy(), memset()
+#include <omp.h>
+
+#include "MandelKernels.h"
+#include "TiledMandelCalculator.h"
+
+// Used when the L2 size can not be read from the system
+static const long DEFAULT_L2_SIZE = 256 * 1024;
+// Used when the page size can not be read from the system
+static const long DEFAULT_PAGE_SIZE = 4096;
+
+
+TiledMandelCalculator::TiledMandelCalculator (unsigned matrixBaseSize, unsigned limit, bool numaAware) :
+	BaseMandelCalculator(matrixBaseSize, limit, "TiledMandelCalculator"), numaAware(numaAware), escape(nullptr)
+{
+	formulasSupported = true;
+
+	// Pages of the numa-aware image must not be shared by the tiles of different threads, so it starts at a page
+	pageSize = sysconf(_SC_PAGESIZE);
+	if (pageSize <= 0) pageSize = DEFAULT_PAGE_SIZE;
+	data = (int*)(_mm_malloc(height * width * sizeof(int), numaAware ? pageSize : 64));
+
+	// Every thread has its own scratch buffers, so the batches do not share cache lines
+	threads = omp_get_max_threads();
+	for (int t = 0; t < threads; ++t){
+		rBuffers.push_back(ScratchBuffer(blockSize));
+		iBuffers.push_back(ScratchBuffer(blockSize));
+	}
+
+	// Tile (its part of data and the mirrored copy) has to fit into half of L2, the rest is left for the buffers and stack
+	long l2Size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+	if (l2Size <= 0) l2Size = DEFAULT_L2_SIZE;
+
+	// Numa-aware tiles are full-width bands of rows, whose bytes are a multiple of the page size. Narrower tiles would
+	// share their pages with the neighbouring tiles (1 KB wide tiles put 4 threads on every 4 KB page), the page would
+	// then stay on the node of whichever of them touched it first. The mirrored bands are page aligned as well when
+	// the whole image is (base sizes that are multiples of 32).
+	if (numaAware){
+		const long pageInts = pageSize / (long)sizeof(int);
+		const long pageRows = pageInts / std::gcd((long)width, pageInts);
+
+		tileWidth = (width + blockSize - 1) / blockSize * blockSize;
+		tileHeight = std::max(1L, l2Size / 2 / (2 * (long)width * (long)sizeof(int)));
+		tileHeight = (tileHeight + pageRows - 1) / pageRows * pageRows;
+	}
+	else {
+		tileWidth = std::min(4 * blockSize, (width + blockSize - 1) / blockSize * blockSize);
+		tileHeight = std::max(1L, l2Size / 2 / (2 * tileWidth * (long)sizeof(int)));
+		tileHeight = std::min(tileHeight, std::max(1, height / 2));
+	}
+
+	tilesX = (width + tileWidth - 1) / tileWidth;
+
+	// Pages of the (untouched) image are placed by the first write, it has to be done by the threads that compute
+	// the tiles later (static schedule of calculate()). The placement follows the tiles of the initial viewport.
+	if (numaAware){
+		const bool symmetric = isSymmetric();
+		const int rows = symmetric ? height / 2 : height;
+		const int tiles = tilesX * ((rows + tileHeight - 1) / tileHeight);
+
+		#pragma omp parallel for num_threads(threads) schedule(static, 1)
+		for (int tile = 0; tile < tiles; ++tile)
+			touchTile(tile, rows, symmetric);
+
+		cVariant = "numa";
+	}
+}
+
+TiledMandelCalculator::~TiledMandelCalculator() {
+	_mm_free(data);
+	_mm_free(escape);
+	data = nullptr;
+	escape = nullptr;
+}
+
+
+void TiledMandelCalculator::setEscapeOutput(bool enabled) {
+
+	// Pages are placed by the first calculation (the threads of the static schedule write them first), the bands
+	// of the numa-aware tiles are page aligned in it as in data (float has the size of int)
+	if (enabled && !escape)
+		escape = (float*)(_mm_malloc(height * width * sizeof(float), numaAware ? pageSize : 64));
+	else if (!enabled){
+		_mm_free(escape);
+		escape = nullptr;
+	}
+}
+
+
+template <typename T, class Formula>
+void TiledMandelCalculator::calculateTile(int tile, int first, int last, bool symmetric, T *rBuffer, T *iBuffer, const Formula &f) {
+
+	const int rowStart = first + (tile / tilesX) * tileHeight;
+	const int rowEnd = std::min(rowStart + tileHeight, last);
+	const int colStart = (tile % tilesX) * tileWidth;
+	const int colEnd = std::min(colStart + tileWidth, width);
+
+	// Iterate rows of the tile
+	for (int i = rowStart; i < rowEnd; ++i){
+		int *pdata = data + width * i;
+		float *pescape = escape ? escape + width * i : nullptr;
+		T y = y_start + i * dy; // current imaginary value
+
+		// Iterate blocks of the row segment (the last block of the row can be shorter)
+		MandelKernels::row(pdata, colStart, colEnd, x_start, dx, y, limit, rBuffer, iBuffer, f, pescape);
+
+		// Copy the row segment of the tile to next half of the image
+		if (symmetric){
+			std::memcpy(data + (height-i-1) * width + colStart, pdata + colStart, (colEnd - colStart) * sizeof(int));
+			if (pescape)
+				std::memcpy(escape + (height-i-1) * width + colStart, pescape + colStart, (colEnd - colStart) * sizeof(float));
+		}
+	}
+}
+
+
+void TiledMandelCalculator::touchTile(int tile, int rows, bool symmetric) {
+
+	const int rowStart = (tile / tilesX) * tileHeight;
+	const int rowEnd = std::min(rowStart + tileHeight, rows);
+	const int colStart = (tile % tilesX) * tileWidth;
+	const int colEnd = std::min(colStart + tileWidth, width);
+
+	for (int i = rowStart; i < rowEnd; ++i){
+		std::memset(data + width * i + colStart, 0, (colEnd - colStart) * sizeof(int));
+		if (symmetric)
+			std::memset(data + (height-i-1) * width + colStart, 0, (colEnd - colStart) * sizeof(int));
+	}
+}
+
+
+int * TiledMandelCalculator::calculateRows (int rowStart, int rowEnd) {
+
+	if (rowStart < 0 || rowEnd > height || rowStart > rowEnd)
+		throw std::invalid_argument("TiledMandelCalculator: invalid band of rows [" + std::to_string(rowStart) + ", " + std::to_string(rowEnd) + ")");
+
+	bandStart = rowStart;
+	bandEnd = rowEnd;
+	int *result = calculateMandelbrot();
+	bandEnd = -1;
+	return result;
+}
+
+
+int * TiledMandelCalculator::calculateMandelbrot () {
+
+	// Float kernels are used while the pixel spacing allows it
+	return needsDoublePrecision() ? dispatch<double>() : dispatch<float>();
+}
+
+
+template <typename T>
+int * TiledMandelCalculator::dispatch () {
+
+	switch (formula.kind){
+		case FractalFormula::MULTIBROT3:   return calculate<T>(Formulas::Multibrot<3>());
+		case FractalFormula::MULTIBROT4:   return calculate<T>(Formulas::Multibrot<4>());
+		case FractalFormula::JULIA:        return calculate<T>(formula.juliaPolicy());
+		case FractalFormula::BURNING_SHIP: return calculate<T>(Formulas::BurningShip());
+		default:                           return calculate<T>(Formulas::Mandelbrot());
+	}
+}
+
+
+template <typename T, class Formula>
+int * TiledMandelCalculator::calculate (const Formula &f) {
+
+	// Due to symmetricity just half of the rows is computed, the rest is mirrored by the tiles
+	int first, last;
+	bool symmetric;
+	computedRows(first, last, symmetric);
+	const int tiles = tilesX * ((last - first + tileHeight - 1) / tileHeight);
+
+	// Tiles near the set boundary are much more expensive than the others, so they are not assigned statically.
+	// Dynamic schedule works as a shared queue of tiles - every idle thread takes the next one.
+	#pragma omp parallel num_threads(threads)
+	{
+		T *rBuffer = rBuffers[omp_get_thread_num()].as<T>();
+		T *iBuffer = iBuffers[omp_get_thread_num()].as<T>();
+
+		if (numaAware){
+			// Every thread computes the tiles it touched (round robin also spreads the expensive tiles)
+			#pragma omp for schedule(static, 1)
+			for (int tile = 0; tile < tiles; ++tile){
+				calculateTile(tile, first, last, symmetric, rBuffer, iBuffer, f);
+			}
+		}
+		else {
+			#pragma omp for schedule(dynamic, 1)
+			for (int tile = 0; tile < tiles; ++tile){
+				calculateTile(tile, first, last, symmetric, rBuffer, iBuffer, f);
+			}
+		}
+	}
+	return data;
+}
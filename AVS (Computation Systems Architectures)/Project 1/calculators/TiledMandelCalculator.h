@@ -0,0 +1,93 @@
+/**
+ * @file TiledMandelCalculator.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Implementation of Mandelbrot calculator that computes L2 sized tiles of batches in parallel (OpenMP)
+ * @date 17.10.2026
+ */
+#ifndef TILEDMANDELCALCULATOR_H
+#define TILEDMANDELCALCULATOR_H
+
+#include <vector>
+
+#include <BaseMandelCalculator.h>
+#include "ScratchBuffer.h"
+
+class TiledMandelCalculator : public BaseMandelCalculator
+{
+public:
+    /**
+     * @brief Construct a new Tiled Mandel Calculator object
+     *
+     * @param matrixBaseSize basic size (width will be multiplied by 3, height by 2)
+     * @param limit number of iterations
+     * @param numaAware true = tiles are page aligned bands of full rows, assigned to the threads statically, and every
+     * thread first-touches its tiles in the constructor, so their pages are on the node of the thread (threads should
+     * be pinned, see NumaTopology)
+     */
+    TiledMandelCalculator(unsigned matrixBaseSize, unsigned limit, bool numaAware = false);
+    ~TiledMandelCalculator();
+    int *calculateMandelbrot();
+
+    /**
+     * @brief Computes only rows [rowStart, rowEnd) of the image (e.g. a band of a distributed render), the rows are
+     * stored at their place in the returned matrix and the rest of it is not changed
+     */
+    int *calculateRows(int rowStart, int rowEnd);
+
+    /**
+     * @brief Enables the output of |z|^2 at the escape of every computed pixel (for Coloring::NORMALIZED of
+     * MandelImageWriter), the values are stored like the matrix
+     */
+    void setEscapeOutput(bool enabled);
+
+    /**
+     * @brief |z|^2 at the escape of the pixels of the last calculation, nullptr if the output is not enabled
+     */
+    const float *escapeValues() const { return escape; }
+
+private:
+    /**
+     * @brief Selects the kernels instantiated for the formula
+     */
+    template <typename T>
+    int *dispatch();
+
+    template <typename T, class Formula>
+    int *calculate(const Formula &f);
+
+    /**
+     * @brief Computes one tile (of the upper half if the viewport is symmetric, the tile is mirrored to the bottom half)
+     *
+     * @param tile index of the tile
+     * @param first first computed row (tiles start at it)
+     * @param last end of the computed rows
+     * @param symmetric true = mirror the tile
+     * @param rBuffer scratch buffer of the calling thread (blockSize elements)
+     * @param iBuffer scratch buffer of the calling thread (blockSize elements)
+     * @param f iterated formula
+     */
+    template <typename T, class Formula>
+    void calculateTile(int tile, int first, int last, bool symmetric, T *rBuffer, T *iBuffer, const Formula &f);
+
+    /**
+     * @brief Writes the tile (and its mirror) first, so its pages are placed on the node of the calling thread
+     */
+    void touchTile(int tile, int rows, bool symmetric);
+
+    static const int blockSize = 64; // batch size (same as BatchMandelCalculator)
+
+    const bool numaAware;
+
+    int *data;
+    float *escape;                // |z|^2 at the escape (only if enabled)
+    int threads;                  // number of threads (and scratch buffers)
+    std::vector<ScratchBuffer> rBuffers; // per-thread scratch buffers (viewed as T* by the kernels)
+    std::vector<ScratchBuffer> iBuffers;
+
+    long pageSize;  // bytes of the memory page (alignment of the numa-aware image)
+    int tileWidth;  // columns in tile (multiple of blockSize)
+    int tileHeight; // rows in tile (numa-aware: its bytes are a multiple of pageSize)
+    int tilesX;     // tiles in a row
+};
+
+#endif
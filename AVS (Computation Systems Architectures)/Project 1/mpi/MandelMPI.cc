@@ -0,0 +1,259 @@
+/**
+ * @file MandelMPI.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Distributed rendering of one image by MPI ranks, every rank computes interleaved bands of rows
+ * @date 17.10.2026
+ *
+ * Build (from Project 1):
+ *   mpicxx -std=c++17 -O3 -march=native -fopenmp -Icalculators mpi/MandelMPI.cc calculators/[A-Z]*.cc -o mandel_mpi
+ *
+ * Usage:
+ *   mpirun [--oversubscribe] -np 4 [-x OMP_NUM_THREADS=2] mandel_mpi [--size 4096] [--limit 1000] [--calc batch|tiled]
+ *          [--band 16] [--view cx,cy,scale] [--output gather|mpiio] [--out mandel.ppm]
+ *
+ * Computed rows (the upper half if the viewport is symmetric) are split into bands of --band rows and band b is
+ * computed by rank b % ranks, so the expensive rows near the set are spread over all ranks. Every rank computes its
+ * bands by calculateRows() of the batch or tiled calculator (OpenMP threads of the rank are used by tiled).
+ *
+ * gather  bands are gathered (MPI_Gatherv) into the image of rank 0, which writes the PPM file
+ * mpiio   every rank colorizes its bands (and their mirrored rows) and writes them to the shared file by MPI-IO
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include <mpi.h>
+
+#include "MandelImageWriter.h"
+#include "BatchMandelCalculator.h"
+#include "TiledMandelCalculator.h"
+
+
+struct Options
+{
+	unsigned size = 4096;
+	unsigned limit = 1000;
+	std::string calculator = "batch";
+	int band = 16;
+	bool viewport = false;
+	double centerReal = 0.0;
+	double centerImag = 0.0;
+	double scale = 0.0;
+	std::string output = "gather";
+	std::string outPath = "mandel.ppm";
+};
+
+/**
+ * @brief Interleaved bands of rows, band b = rows [b * rows, min((b + 1) * rows, computedRows)) of rank b % ranks
+ */
+struct BandLayout
+{
+	int computedRows;
+	int rows;
+	int ranks;
+
+	int bands() const { return (computedRows + rows - 1) / rows; }
+	int start(int b) const { return b * rows; }
+	int end(int b) const { return std::min((b + 1) * rows, computedRows); }
+
+	/**
+	 * @brief Number of rows computed by the rank
+	 */
+	int rowsOf(int rank) const
+	{
+		int count = 0;
+		for (int b = rank; b < bands(); b += ranks)
+			count += end(b) - start(b);
+		return count;
+	}
+};
+
+
+static Options parseOptions(int argc, char *argv[])
+{
+	Options opts;
+	for (int a = 1; a < argc; ++a){
+		const std::string arg = argv[a];
+		const bool hasValue = a + 1 < argc;
+
+		if (arg == "--size" && hasValue)        opts.size = std::stoul(argv[++a]);
+		else if (arg == "--limit" && hasValue)  opts.limit = std::stoul(argv[++a]);
+		else if (arg == "--calc" && hasValue)   opts.calculator = argv[++a];
+		else if (arg == "--band" && hasValue)   opts.band = std::stoi(argv[++a]);
+		else if (arg == "--output" && hasValue) opts.output = argv[++a];
+		else if (arg == "--out" && hasValue)    opts.outPath = argv[++a];
+		else if (arg == "--view" && hasValue){
+			std::stringstream ss(argv[++a]);
+			char comma1 = 0, comma2 = 0;
+			if (!(ss >> opts.centerReal >> comma1 >> opts.centerImag >> comma2 >> opts.scale) || comma1 != ',' || comma2 != ',')
+				throw std::invalid_argument("expected --view cx,cy,scale");
+			opts.viewport = true;
+		}
+		else throw std::invalid_argument("unknown or incomplete option '" + arg + "'");
+	}
+
+	if (opts.band < 1)
+		throw std::invalid_argument("band has to have at least one row");
+	if (opts.calculator != "batch" && opts.calculator != "tiled")
+		throw std::invalid_argument("unknown calculator '" + opts.calculator + "' (batch, tiled)");
+	if (opts.output != "gather" && opts.output != "mpiio")
+		throw std::invalid_argument("unknown output '" + opts.output + "' (gather, mpiio)");
+	return opts;
+}
+
+
+/**
+ * @brief Collects the bands of all ranks into the image of rank 0 (its own bands are already in place)
+ */
+static void gatherBands(int *image, int width, const BandLayout &layout, int rank)
+{
+	std::vector<int> packed;
+	packed.reserve(size_t(layout.rowsOf(rank)) * width);
+	for (int b = rank; b < layout.bands(); b += layout.ranks)
+		packed.insert(packed.end(), image + size_t(layout.start(b)) * width, image + size_t(layout.end(b)) * width);
+
+	std::vector<int> counts(layout.ranks), displs(layout.ranks);
+	for (int r = 0, offset = 0; r < layout.ranks; ++r){
+		counts[r] = layout.rowsOf(r) * width;
+		displs[r] = offset;
+		offset += counts[r];
+	}
+
+	std::vector<int> gathered(rank == 0 ? size_t(layout.computedRows) * width : 0);
+	MPI_Gatherv(packed.data(), int(packed.size()), MPI_INT, gathered.data(), counts.data(), displs.data(), MPI_INT, 0,
+	            MPI_COMM_WORLD);
+	if (rank != 0) return;
+
+	for (int r = 0; r < layout.ranks; ++r){
+		const int *src = gathered.data() + displs[r];
+		for (int b = r; b < layout.bands(); b += layout.ranks){
+			const size_t count = size_t(layout.end(b) - layout.start(b)) * width;
+			std::copy(src, src + count, image + size_t(layout.start(b)) * width);
+			src += count;
+		}
+	}
+}
+
+/**
+ * @brief Every rank writes its colorized bands (and the mirrored rows of a half image) to the shared PPM file
+ *
+ * @return false if the file can not be written (on any rank)
+ */
+static bool writeBands(const std::string &path, const MandelImageView<int> &image, const BandLayout &layout, int rank,
+                       int limit, const MandelPalette &palette)
+{
+	const std::string header = "P6\n" + std::to_string(image.width) + " " + std::to_string(image.height) + "\n255\n";
+	const MPI_Offset rowBytes = MPI_Offset(image.width) * 3;
+
+	MPI_File file;
+	if (MPI_File_open(MPI_COMM_WORLD, path.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS)
+		return false;
+
+	// Previous content of the file must not remain behind the image
+	bool ok = MPI_File_set_size(file, MPI_Offset(header.size()) + rowBytes * image.height) == MPI_SUCCESS;
+	if (rank == 0)
+		ok &= MPI_File_write_at(file, 0, header.data(), int(header.size()), MPI_BYTE, MPI_STATUS_IGNORE) == MPI_SUCCESS;
+
+	// Encoded rows start behind the header of encodePPM(), mirrored rows of a band are contiguous as well
+	auto write = [&](int rowStart, int rows){
+		const std::string encoded = MandelImageWriter::encodePPM(image, rowStart, 0, rows, image.width, limit, palette);
+		const size_t payload = size_t(rows) * rowBytes;
+		const MPI_Offset offset = MPI_Offset(header.size()) + rowStart * rowBytes;
+		ok &= MPI_File_write_at(file, offset, encoded.data() + encoded.size() - payload, int(payload), MPI_BYTE,
+		                        MPI_STATUS_IGNORE) == MPI_SUCCESS;
+	};
+	for (int b = rank; b < layout.bands(); b += layout.ranks){
+		write(layout.start(b), layout.end(b) - layout.start(b));
+		if (image.isHalf())
+			write(image.height - layout.end(b), layout.end(b) - layout.start(b));
+	}
+
+	ok &= MPI_File_close(&file) == MPI_SUCCESS;
+
+	int allOk = ok;
+	MPI_Allreduce(MPI_IN_PLACE, &allOk, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+	return allOk;
+}
+
+
+template <class Calc>
+static int render(const Options &opts, int rank, int ranks)
+{
+	Calc calc(opts.size, opts.limit);
+	if (opts.viewport)
+		calc.setViewport(opts.centerReal, opts.centerImag, opts.scale);
+
+	const bool symmetric = calc.isSymmetric();
+	const BandLayout layout{symmetric ? calc.height / 2 : calc.height, opts.band, ranks};
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	const double start = MPI_Wtime();
+
+	// Empty band only returns the image (a rank may have no band of a small image)
+	int *image = calc.calculateRows(0, 0);
+	for (int b = rank; b < layout.bands(); b += ranks)
+		image = calc.calculateRows(layout.start(b), layout.end(b));
+
+	const double computed = MPI_Wtime();
+	const MandelImageView<int> view{image, calc.width, calc.height, layout.computedRows};
+	const MandelPalette palette = MandelPalette::standard();
+
+	bool ok;
+	if (opts.output == "gather"){
+		gatherBands(image, calc.width, layout, rank);
+		ok = rank != 0 || MandelImageWriter::writePPM(opts.outPath, view, opts.limit, palette);
+		MPI_Bcast(&ok, 1, MPI_CXX_BOOL, 0, MPI_COMM_WORLD);
+	}
+	else {
+		ok = writeBands(opts.outPath, view, layout, rank, opts.limit, palette);
+	}
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	const double finished = MPI_Wtime();
+
+	// Compute times show the balance of the interleaved bands
+	double computeMs = (computed - start) * 1000.0;
+	std::vector<double> times(rank == 0 ? ranks : 0);
+	MPI_Gather(&computeMs, 1, MPI_DOUBLE, times.data(), 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+	if (rank == 0){
+		for (int r = 0; r < ranks; ++r)
+			std::cout << "rank " << r << ": " << layout.rowsOf(r) << " rows, " << times[r] << " ms" << std::endl;
+		std::cout << opts.calculator << " " << calc.width << "x" << calc.height << ", " << layout.bands() << " bands of "
+		          << layout.rows << " rows" << (symmetric ? " (mirrored)" : "") << ", " << opts.output << ": "
+		          << (finished - start) * 1000.0 << " ms" << std::endl;
+		if (!ok)
+			std::cerr << "mandel_mpi: can not write '" << opts.outPath << "'" << std::endl;
+	}
+	return ok ? 0 : 1;
+}
+
+
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc, &argv);
+
+	int rank, ranks;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &ranks);
+
+	// All ranks parse the same arguments, so they all fail or all continue
+	Options opts;
+	int status;
+	try {
+		opts = parseOptions(argc, argv);
+		status = opts.calculator == "tiled" ? render<TiledMandelCalculator>(opts, rank, ranks)
+		                                    : render<BatchMandelCalculator>(opts, rank, ranks);
+	} catch (const std::exception &e) {
+		if (rank == 0)
+			std::cerr << "mandel_mpi: " << e.what() << std::endl;
+		status = 1;
+	}
+
+	MPI_Finalize();
+	return status;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file TileCache.h
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief LRU cache of encoded map tiles limited by their total size
+ * @date 17.10.2026
+ */
+#ifndef TILECACHE_H
+#define TILECACHE_H
+
+#include <list>
+#include <string>
+#include <utility>
+#include <unordered_map>
+
+/**
+ * @brief Tile z/x/y of the map (2^z x 2^z tiles at zoom z)
+ */
+struct TileKey
+{
+    int z;
+    long x;
+    long y;
+
+    bool operator==(const TileKey &other) const { return z == other.z && x == other.x && y == other.y; }
+};
+
+struct TileKeyHash
+{
+    size_t operator()(const TileKey &key) const
+    {
+        size_t h = std::hash<long>()(key.x);
+        h = h * 31 + std::hash<long>()(key.y);
+        return h * 31 + std::hash<int>()(key.z);
+    }
+};
+
+/**
+ * @brief Least recently used tiles are evicted when the encoded tiles exceed the capacity
+ */
+class TileCache
+{
+public:
+    explicit TileCache(size_t capacityBytes) : capacity(capacityBytes) {}
+
+    /**
+     * @brief Finds the tile and marks it as the most recently used
+     */
+    const std::string *get(const TileKey &key)
+    {
+        auto it = index.find(key);
+        if (it == index.end())
+        {
+            ++missCount;
+            return nullptr;
+        }
+        ++hitCount;
+        order.splice(order.begin(), order, it->second);
+        return &it->second->second;
+    }
+
+    /**
+     * @brief Inserts (or replaces) the tile as the most recently used one
+     */
+    void put(const TileKey &key, std::string tile)
+    {
+        auto it = index.find(key);
+        if (it != index.end())
+        {
+            usedBytes -= it->second->second.size();
+            order.erase(it->second);
+            index.erase(it);
+        }
+
+        usedBytes += tile.size();
+        order.emplace_front(key, std::move(tile));
+        index[key] = order.begin();
+
+        // The newest tile is kept even if it alone exceeds the capacity
+        while (usedBytes > capacity && order.size() > 1)
+        {
+            usedBytes -= order.back().second.size();
+            index.erase(order.back().first);
+            order.pop_back();
+        }
+    }
+
+    size_t tiles() const { return order.size(); }
+    size_t bytes() const { return usedBytes; }
+    long hits() const { return hitCount; }
+    long misses() const { return missCount; }
+
+private:
+    using Entry = std::pair<TileKey, std::string>;
+
+    const size_t capacity;
+    size_t usedBytes = 0;
+    long hitCount = 0;
+    long missCount = 0;
+
+    std::list<Entry> order; // the most recently used first
+    std::unordered_map<TileKey, std::list<Entry>::iterator, TileKeyHash> index;
+};
+
+#endif
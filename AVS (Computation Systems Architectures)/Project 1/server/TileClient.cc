@@ -0,0 +1,190 @@
+/**
+ * @file TileClient.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Local test client of the tile server (see TileServer.cc)
+ * @date 17.10.2026
+ *
+ * Build (from Project 1):
+ *   g++ -std=c++17 -O2 server/TileClient.cc -o mandel_tile_client
+ *
+ * Usage:
+ *   mandel_tile_client [--socket /tmp/mandel_tiles.sock] [--out dir] [--around z/x/y/radius] [--stats] [z/x/y ...]
+ *
+ * All requests are sent before the first response is read, so the server receives them as one batch. Tiles are
+ * written to dir/z_x_y.ppm if --out is given. --around requests the (2 * radius + 1)^2 tiles around z/x/y.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <stdexcept>
+
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+
+static bool sendAll(int fd, const std::string &data)
+{
+	size_t sent = 0;
+	while (sent < data.size()){
+		const ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+		if (n <= 0) return false;
+		sent += n;
+	}
+	return true;
+}
+
+/**
+ * @brief Buffered reading of the responses
+ */
+class Reader
+{
+public:
+	explicit Reader(int fd) : fd(fd) {}
+
+	bool line(std::string &out)
+	{
+		size_t newline;
+		while ((newline = buffer.find('\n')) == std::string::npos)
+			if (!fill()) return false;
+		out = buffer.substr(0, newline);
+		buffer.erase(0, newline + 1);
+		return true;
+	}
+
+	bool bytes(size_t count, std::string &out)
+	{
+		while (buffer.size() < count)
+			if (!fill()) return false;
+		out = buffer.substr(0, count);
+		buffer.erase(0, count);
+		return true;
+	}
+
+private:
+	bool fill()
+	{
+		char chunk[65536];
+		const ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+		if (n <= 0) return false;
+		buffer.append(chunk, n);
+		return true;
+	}
+
+	const int fd;
+	std::string buffer;
+};
+
+/**
+ * @brief Numbers of "a/b/c[/d]"
+ */
+static std::vector<long> splitPath(const std::string &str)
+{
+	std::vector<long> numbers;
+	std::stringstream ss(str);
+	std::string item;
+	while (std::getline(ss, item, '/')){
+		try {
+			numbers.push_back(std::stol(item));
+		} catch (const std::exception &) {
+			throw std::invalid_argument("'" + str + "' is not a tile path");
+		}
+	}
+	return numbers;
+}
+
+
+int main(int argc, char *argv[])
+{
+	std::string socketPath = "/tmp/mandel_tiles.sock";
+	std::string outDir;
+	std::vector<std::string> requests; // request lines
+
+	try {
+		for (int a = 1; a < argc; ++a){
+			const std::string arg = argv[a];
+			const bool hasValue = a + 1 < argc;
+
+			if (arg == "--socket" && hasValue)   socketPath = argv[++a];
+			else if (arg == "--out" && hasValue) outDir = argv[++a];
+			else if (arg == "--stats")           requests.push_back("STATS");
+			else if (arg == "--around" && hasValue){
+				const std::vector<long> p = splitPath(argv[++a]);
+				if (p.size() != 4) throw std::invalid_argument("expected z/x/y/radius");
+				for (long y = p[2] - p[3]; y <= p[2] + p[3]; ++y)
+					for (long x = p[1] - p[3]; x <= p[1] + p[3]; ++x)
+						requests.push_back("TILE " + std::to_string(p[0]) + " " + std::to_string(x) + " " + std::to_string(y));
+			}
+			else {
+				const std::vector<long> p = splitPath(arg);
+				if (p.size() != 3) throw std::invalid_argument("expected z/x/y, got '" + arg + "'");
+				requests.push_back("TILE " + std::to_string(p[0]) + " " + std::to_string(p[1]) + " " + std::to_string(p[2]));
+			}
+		}
+	} catch (const std::exception &e) {
+		std::cerr << "mandel_tile_client: " << e.what() << std::endl;
+		return 1;
+	}
+
+	sockaddr_un addr{};
+	addr.sun_family = AF_UNIX;
+	if (socketPath.size() >= sizeof(addr.sun_path)){
+		std::cerr << "mandel_tile_client: socket path too long" << std::endl;
+		return 1;
+	}
+	std::copy(socketPath.begin(), socketPath.end(), addr.sun_path);
+
+	const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0 || connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0){
+		perror("mandel_tile_client");
+		return 1;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	std::string all;
+	for (const std::string &request : requests)
+		all += request + "\n";
+	if (!sendAll(fd, all)){
+		perror("mandel_tile_client");
+		return 1;
+	}
+
+	int failed = 0;
+	Reader reader(fd);
+	for (const std::string &request : requests){
+		std::string status;
+		if (!reader.line(status)){
+			std::cerr << "mandel_tile_client: connection closed" << std::endl;
+			return 1;
+		}
+
+		const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		if (status.rfind("OK", 0) != 0 || request == "STATS"){
+			failed += status.rfind("OK", 0) != 0;
+			std::cout << request << ": " << status << std::endl;
+			continue;
+		}
+
+		std::string tile;
+		if (!reader.bytes(std::stoul(status.substr(3)), tile)){
+			std::cerr << "mandel_tile_client: connection closed" << std::endl;
+			return 1;
+		}
+		std::cout << request << ": " << tile.size() << " bytes, " << ms << " ms" << std::endl;
+
+		if (!outDir.empty()){
+			std::istringstream in(request.substr(5));
+			std::string z, x, y;
+			in >> z >> x >> y;
+			std::ofstream(outDir + "/" + z + "_" + x + "_" + y + ".ppm", std::ios::binary) << tile;
+		}
+	}
+
+	close(fd);
+	return failed ? 2 : 0;
+}
@@ -0,0 +1,397 @@
+/**
+ * @file TileServer.cc
+ * @author Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ * @brief Long-running service of map-style Mandelbrot tiles (z/x/y) on a Unix domain socket with LRU tile cache
+ * @date 17.10.2026
+ *
+ * Build (from Project 1):
+ *   g++ -std=c++17 -O3 -march=native -fopenmp -Icalculators -Iserver server/TileServer.cc calculators/[A-Z]*.cc -o mandel_tile_server
+ *
+ * Usage:
+ *   mandel_tile_server [--socket /tmp/mandel_tiles.sock] [--tile 256] [--limit 1000] [--cache-mb 256]
+ *                      [--calc auto|batch|tiled]
+ *
+ * Protocol (one request per line, responses in the order of the requests of the connection):
+ *   TILE z x y   ->  "OK <bytes>\n" followed by the tile encoded as PPM (P6), or "ERR <message>\n"
+ *   STATS        ->  "OK tiles=<n> bytes=<n> hits=<n> misses=<n> blocks=<n>\n"
+ *
+ * Zoom z has 2^z x 2^z tiles covering [-2.5, 1.5] x [-2, 2]. Tiles are rendered in blocks of 3 x 2 neighbouring tiles
+ * (one image of the calculators, width = 3 * tile, height = 2 * tile), so one SIMD pass renders all missing tiles
+ * of a block requested together and the other tiles of the block are cached for the following requests.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+#include <csignal>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <omp.h>
+
+#include "TileCache.h"
+#include "MandelImageWriter.h"
+#include "BatchMandelCalculator.h"
+#include "TiledMandelCalculator.h"
+
+// Part of the complex plane covered by the tile of zoom 0
+static const double WORLD_REAL = -2.5;
+static const double WORLD_IMAG = -2.0;
+static const double WORLD_SIZE = 4.0;
+
+static const int MAX_ZOOM = 40;         // pixels are not distinguishable in double precision much deeper
+static const int BLOCK_TILES_X = 3;     // block of tiles is one image of the calculators (3:2)
+static const int BLOCK_TILES_Y = 2;
+static const size_t MAX_REQUEST_LINE = 256;
+static const size_t MAX_QUEUED_OUTPUT = 16 * 1024 * 1024; // requests of the client are not read while more is queued
+
+static volatile sig_atomic_t stopRequested = 0;
+
+
+struct Options
+{
+	std::string socketPath = "/tmp/mandel_tiles.sock";
+	unsigned tileSize = 256;
+	unsigned limit = 1000;
+	size_t cacheMb = 256;
+	std::string calculator = "auto";
+};
+
+/**
+ * @brief Connection of a client (the socket is non-blocking, responses wait in the queue until the client reads them)
+ */
+struct Client
+{
+	std::string pending; // unfinished request line
+	std::string output;  // queued responses, output[0, sent) is already sent
+	size_t sent = 0;
+};
+
+/**
+ * @brief Parsed request line of a client
+ */
+struct Request
+{
+	int fd;
+	bool stats;
+	TileKey key;
+	std::string error; // non-empty = invalid request
+};
+
+
+/**
+ * @brief Renders blocks of tiles by the calculator Calc (its buffers are reused by all blocks)
+ */
+template <typename Calc>
+class BlockRenderer
+{
+public:
+	BlockRenderer(unsigned tileSize, unsigned limit) :
+		calc(tileSize, limit), tileSize(tileSize), limit(limit), palette(MandelPalette::standard()) {}
+
+	/**
+	 * @brief Renders the block (bx, by) of zoom z and encodes its tiles that exist on the map
+	 */
+	void render(int z, long bx, long by, std::vector<std::pair<TileKey, std::string>> &tiles)
+	{
+		const int width = BLOCK_TILES_X * tileSize;
+		const int height = BLOCK_TILES_Y * tileSize;
+		const double pixel = std::ldexp(WORLD_SIZE / tileSize, -z);
+
+		// Pixel (i, j) of the block is at its origin + (j, i) * pixel, the same grid as of the neighbouring blocks
+		const double realStart = WORLD_REAL + bx * width * pixel;
+		const double imagStart = WORLD_IMAG + by * height * pixel;
+		const double scale = pixel * (width - 1);
+		calc.setViewport(realStart + scale / 2.0, imagStart + pixel * (height - 1) / 2.0, scale, double(height - 1) / (width - 1));
+
+		const MandelImageView<int> view = MandelImageWriter::fullView(calc.calculateMandelbrot(), width, height);
+
+		const long tiles1D = 1L << z;
+		for (int ty = 0; ty < BLOCK_TILES_Y; ++ty){
+			for (int tx = 0; tx < BLOCK_TILES_X; ++tx){
+				const TileKey key{z, bx * BLOCK_TILES_X + tx, by * BLOCK_TILES_Y + ty};
+				if (key.x >= tiles1D || key.y >= tiles1D) continue;
+
+				tiles.emplace_back(key, MandelImageWriter::encodePPM(view, ty * tileSize, tx * tileSize, tileSize, tileSize,
+				                                                     limit, palette));
+			}
+		}
+	}
+
+	std::string name()
+	{
+		std::ostringstream info;
+		calc.info(info, true);
+		return info.str().substr(0, info.str().find(';'));
+	}
+
+private:
+	Calc calc;
+	const int tileSize;
+	const int limit;
+	const MandelPalette palette;
+};
+
+
+/**
+ * @brief Sends the queued responses until the socket buffer is full, false if the connection failed
+ */
+static bool flush(int fd, Client &client)
+{
+	while (client.sent < client.output.size()){
+		const ssize_t n = send(fd, client.output.data() + client.sent, client.output.size() - client.sent, MSG_NOSIGNAL);
+		if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+		if (n < 0 && errno == EINTR) continue;
+		if (n <= 0) return false;
+		client.sent += n;
+	}
+	client.output.clear();
+	client.sent = 0;
+	return true;
+}
+
+static Request parseRequest(int fd, const std::string &line)
+{
+	Request request{fd, false, TileKey{0, 0, 0}, ""};
+
+	std::istringstream in(line);
+	std::string command;
+	in >> command;
+
+	if (command == "STATS"){
+		request.stats = true;
+		return request;
+	}
+	if (command != "TILE" || !(in >> request.key.z >> request.key.x >> request.key.y)){
+		request.error = "expected 'TILE z x y' or 'STATS'";
+		return request;
+	}
+
+	const TileKey &key = request.key;
+	if (key.z < 0 || key.z > MAX_ZOOM)
+		request.error = "zoom out of range 0.." + std::to_string(MAX_ZOOM);
+	else if (key.x < 0 || key.y < 0 || key.x >= (1L << key.z) || key.y >= (1L << key.z))
+		request.error = "tile out of range of zoom " + std::to_string(key.z);
+	return request;
+}
+
+
+/**
+ * @brief Serves the tiles until SIGINT / SIGTERM
+ */
+template <typename Calc>
+static int serve(const Options &opts, int listenFd)
+{
+	BlockRenderer<Calc> renderer(opts.tileSize, opts.limit);
+	TileCache cache(opts.cacheMb * 1024 * 1024);
+	long blocksRendered = 0;
+
+	std::cerr << "mandel_tile_server: " << renderer.name() << ", tile " << opts.tileSize << ", limit " << opts.limit
+	          << ", listening on " << opts.socketPath << std::endl;
+
+	// A client that does not read its responses must not block the others, so the sockets are non-blocking and
+	// the responses are queued per client and sent whenever its socket is writable
+	std::map<int, Client> clients;
+	auto disconnect = [&](int fd){
+		close(fd);
+		clients.erase(fd);
+	};
+
+	while (!stopRequested){
+		std::vector<pollfd> fds;
+		fds.push_back(pollfd{listenFd, POLLIN, 0});
+		for (const auto &client : clients){
+			const size_t queued = client.second.output.size() - client.second.sent;
+			const short events = (queued < MAX_QUEUED_OUTPUT ? POLLIN : 0) | (queued > 0 ? POLLOUT : 0);
+			fds.push_back(pollfd{client.first, events, 0});
+		}
+
+		if (poll(fds.data(), fds.size(), -1) < 0) continue; // interrupted by a signal
+
+		if (fds[0].revents & POLLIN){
+			const int fd = accept(listenFd, nullptr, nullptr);
+			if (fd >= 0 && fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == 0)
+				clients[fd] = Client();
+			else if (fd >= 0)
+				close(fd);
+		}
+
+		// Requests that arrived together are handled as one batch
+		std::vector<Request> requests;
+		for (size_t f = 1; f < fds.size(); ++f){
+			const int fd = fds[f].fd;
+			if ((fds[f].revents & POLLOUT) && !flush(fd, clients[fd])){
+				disconnect(fd);
+				continue;
+			}
+			if (!(fds[f].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+
+			char buffer[4096];
+			const ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+			if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) continue;
+			if (n <= 0){
+				disconnect(fd);
+				continue;
+			}
+
+			std::string &pending = clients[fd].pending;
+			pending.append(buffer, n);
+
+			size_t newline;
+			while ((newline = pending.find('\n')) != std::string::npos){
+				requests.push_back(parseRequest(fd, pending.substr(0, newline)));
+				pending.erase(0, newline + 1);
+			}
+			if (pending.size() > MAX_REQUEST_LINE){
+				requests.push_back(Request{fd, false, TileKey{0, 0, 0}, "request line too long"});
+				pending.clear();
+			}
+		}
+		if (requests.empty()) continue;
+
+		// Tiles of this batch are kept aside, the cache may evict them while the missing blocks are rendered
+		std::unordered_map<TileKey, std::string, TileKeyHash> batch;
+
+		// Blocks of the missing tiles, every block is rendered once for all requests of the batch
+		std::set<std::tuple<int, long, long>> blocks;
+		for (const Request &request : requests){
+			if (request.stats || !request.error.empty() || batch.count(request.key)) continue;
+
+			if (const std::string *tile = cache.get(request.key))
+				batch[request.key] = *tile;
+			else
+				blocks.insert(std::make_tuple(request.key.z, request.key.x / BLOCK_TILES_X, request.key.y / BLOCK_TILES_Y));
+		}
+
+		for (const auto &block : blocks){
+			std::vector<std::pair<TileKey, std::string>> tiles;
+			renderer.render(std::get<0>(block), std::get<1>(block), std::get<2>(block), tiles);
+			++blocksRendered;
+
+			for (auto &tile : tiles){
+				cache.put(tile.first, tile.second);
+				batch[tile.first] = std::move(tile.second);
+			}
+		}
+
+		for (const Request &request : requests){
+			std::string response;
+			if (!request.error.empty()){
+				response = "ERR " + request.error + "\n";
+			}
+			else if (request.stats){
+				response = "OK tiles=" + std::to_string(cache.tiles()) + " bytes=" + std::to_string(cache.bytes()) +
+				           " hits=" + std::to_string(cache.hits()) + " misses=" + std::to_string(cache.misses()) +
+				           " blocks=" + std::to_string(blocksRendered) + "\n";
+			}
+			else {
+				const std::string &tile = batch[request.key];
+				response = "OK " + std::to_string(tile.size()) + "\n" + tile;
+			}
+
+			auto client = clients.find(request.fd);
+			if (client != clients.end())
+				client->second.output += response;
+		}
+
+		// Responses are sent right away as far as the socket buffers allow, the rest on POLLOUT
+		for (auto client = clients.begin(); client != clients.end();){
+			const int fd = client->first;
+			const bool ok = flush(fd, client->second);
+			++client;
+			if (!ok) disconnect(fd);
+		}
+	}
+
+	for (const auto &client : clients)
+		close(client.first);
+	return 0;
+}
+
+
+static Options parseOptions(int argc, char *argv[])
+{
+	Options opts;
+	for (int a = 1; a < argc; ++a){
+		const std::string arg = argv[a];
+		const bool hasValue = a + 1 < argc;
+
+		if (arg == "--socket" && hasValue)        opts.socketPath = argv[++a];
+		else if (arg == "--tile" && hasValue)     opts.tileSize = std::stoul(argv[++a]);
+		else if (arg == "--limit" && hasValue)    opts.limit = std::stoul(argv[++a]);
+		else if (arg == "--cache-mb" && hasValue) opts.cacheMb = std::stoul(argv[++a]);
+		else if (arg == "--calc" && hasValue)     opts.calculator = argv[++a];
+		else throw std::invalid_argument("unknown or incomplete option '" + arg + "'");
+	}
+
+	if (opts.tileSize < 16)
+		throw std::invalid_argument("tile size has to be at least 16");
+	if (opts.calculator != "auto" && opts.calculator != "batch" && opts.calculator != "tiled")
+		throw std::invalid_argument("unknown calculator '" + opts.calculator + "' (auto, batch, tiled)");
+	return opts;
+}
+
+static void requestStop(int)
+{
+	stopRequested = 1;
+}
+
+
+int main(int argc, char *argv[])
+{
+	Options opts;
+	try {
+		opts = parseOptions(argc, argv);
+	} catch (const std::exception &e) {
+		std::cerr << "mandel_tile_server: " << e.what() << std::endl;
+		return 1;
+	}
+
+	sockaddr_un addr{};
+	addr.sun_family = AF_UNIX;
+	if (opts.socketPath.size() >= sizeof(addr.sun_path)){
+		std::cerr << "mandel_tile_server: socket path too long" << std::endl;
+		return 1;
+	}
+	std::copy(opts.socketPath.begin(), opts.socketPath.end(), addr.sun_path);
+
+	const int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+	unlink(opts.socketPath.c_str());
+	if (listenFd < 0 || bind(listenFd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listenFd, 64) != 0){
+		perror("mandel_tile_server");
+		return 1;
+	}
+
+	// Handlers without SA_RESTART interrupt poll(), so the loop sees the stop request
+	struct sigaction action{};
+	action.sa_handler = requestStop;
+	sigaction(SIGINT, &action, nullptr);
+	sigaction(SIGTERM, &action, nullptr);
+
+	// Tiled calculator uses all threads, the tuned batch kernels are the fastest on a single thread
+	const bool tiled = opts.calculator == "tiled" || (opts.calculator == "auto" && omp_get_max_threads() > 1);
+
+	int status;
+	try {
+		status = tiled ? serve<TiledMandelCalculator>(opts, listenFd) : serve<BatchMandelCalculator>(opts, listenFd);
+	} catch (const std::exception &e) {
+		std::cerr << "mandel_tile_server: " << e.what() << std::endl;
+		status = 1;
+	}
+
+	close(listenFd);
+	unlink(opts.socketPath.c_str());
+	return status;
+}
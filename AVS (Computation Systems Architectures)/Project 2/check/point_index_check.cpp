@@ -0,0 +1,108 @@
+/**
+ * @file    point_index_check.cpp
+ *
+ * @author  Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ *
+ * @brief   Check of the PointIndex queries against the linear scan of all points
+ *
+ * @date    17.10.2026
+ *
+ * Build (from Project 2, next to the common/ directory of the course framework, with its flags):
+ *   g++ -std=c++17 -O3 -march=native -fopenmp -Iparallel_builder -Icommon check/point_index_check.cpp parallel_builder/point_index.cpp -o point_index_check
+ *
+ * Usage:
+ *   point_index_check [points] [queries] [seed]
+ *
+ * Points are a noisy sphere with uniform outliers (like the fields of the course), queries are random positions
+ * around them, grid-like batches of neighbouring positions and the points themselves. nearestSquared() (single and
+ * batched) has to equal the minimum of the scan, hasPointWithin() has to agree with the scan for the distance of the
+ * nearest point, the floats next to it and a random distance. The exit code is 1 on any mismatch.
+ **/
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <limits>
+#include <string>
+#include <math.h>
+
+#include "point_index.h"
+
+// Same expression as the leaves of the index, so it is contracted into FMAs the same way with the same flags
+static float scanSquared(const std::vector<Vec3_t<float>> &points, const Vec3_t<float> &pos)
+{
+    float value = std::numeric_limits<float>::max();
+    for(const Vec3_t<float> &p : points)
+    {
+        float distanceSquared  = (pos.x - p.x) * (pos.x - p.x);
+        distanceSquared       += (pos.y - p.y) * (pos.y - p.y);
+        distanceSquared       += (pos.z - p.z) * (pos.z - p.z);
+        value = std::min(value, distanceSquared);
+    }
+    return value;
+}
+
+int main(int argc, char *argv[])
+{
+    const unsigned pointCount = argc > 1 ? std::stoul(argv[1]) : 20000;
+    const unsigned queryCount = argc > 2 ? std::stoul(argv[2]) : 40000;
+    const unsigned seed = argc > 3 ? std::stoul(argv[3]) : 1;
+
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    std::uniform_real_distribution<float> uniform(0.0f, 64.0f);
+    std::uniform_real_distribution<float> around(-16.0f, 80.0f);
+
+    // 1. Noisy sphere of radius 20 in the middle of the grid and 2 % of uniform outliers.
+    std::vector<Vec3_t<float>> points;
+    for(unsigned i = 0; i < pointCount; ++i)
+    {
+        if(i % 50 == 0)
+        {
+            points.emplace_back(uniform(rng), uniform(rng), uniform(rng));
+            continue;
+        }
+        const float x = normal(rng), y = normal(rng), z = normal(rng);
+        const float r = 20.0f / sqrtf(x * x + y * y + z * z);
+        points.emplace_back(32.0f + x * r + 0.3f * normal(rng), 32.0f + y * r, 32.0f + z * r);
+    }
+
+    PointIndex index;
+    index.build(points);
+
+    // 2. Queries, every batch is a row of neighbouring grid positions (as in the loop builder).
+    unsigned nearestErrors = 0, batchErrors = 0, withinErrors = 0;
+    for(unsigned q = 0; q < queryCount; q += PointIndex::BATCH_SIZE)
+    {
+        Vec3_t<float> batch[PointIndex::BATCH_SIZE];
+        const Vec3_t<float> start = (q % 3 == 0) ? points[rng() % points.size()]
+                                                 : Vec3_t<float>(around(rng), around(rng), around(rng));
+        for(unsigned k = 0; k < PointIndex::BATCH_SIZE; ++k)
+            batch[k] = Vec3_t<float>(start.x + 0.5f * k, start.y, start.z);
+
+        float values[PointIndex::BATCH_SIZE];
+        index.nearestSquared(batch, PointIndex::BATCH_SIZE, values);
+
+        for(unsigned k = 0; k < PointIndex::BATCH_SIZE; ++k)
+        {
+            const Vec3_t<float> &pos = batch[k];
+            const float expected = scanSquared(points, pos);
+
+            nearestErrors += index.nearestSquared(pos) != expected;
+            batchErrors += values[k] != expected;
+
+            // The nearest point is exactly at its distance, the float below it is too close for any point.
+            const float distance = sqrtf(expected);
+            const float distances[] = {distance, nextafterf(distance, 0.0f), nextafterf(distance, INFINITY),
+                                       std::uniform_real_distribution<float>(0.0f, 8.0f)(rng)};
+            for(float d : distances)
+                withinErrors += index.hasPointWithin(pos, d) != (distance <= d);
+        }
+    }
+
+    std::cout << "points;queries;nearest_errors;batch_errors;within_errors" << std::endl;
+    std::cout << pointCount << ";" << queryCount << ";" << nearestErrors << ";" << batchErrors << ";" << withinErrors
+              << std::endl;
+
+    return (nearestErrors + batchErrors + withinErrors) > 0 ? 1 : 0;
+}
@@ -11,69 +11,148 @@
 #include <iostream>
 #include <math.h>
 #include <limits>
+#include <algorithm>
 
 #include "loop_mesh_builder.h"
 
-LoopMeshBuilder::LoopMeshBuilder(unsigned gridEdgeSize)
-    : BaseMeshBuilder(gridEdgeSize, "OpenMP Loop")
+LoopMeshBuilder::LoopMeshBuilder(unsigned gridEdgeSize, bool cacheField)
+    : BaseMeshBuilder(gridEdgeSize, "OpenMP Loop"), mCacheField(cacheField)
 {
 
 }
 
 unsigned LoopMeshBuilder::marchCubes(const ParametricScalarField &field)
 {
-    // 1. Compute total number of cubes in the grid.
+    // 1. Compute total number of cubes in the grid and index the points of the field
+    //    (every "evaluateFieldAt(...)" call then searches only the nearby points).
     size_t totalCubesCount = mGridSize*mGridSize*mGridSize;
+    mPointIndex.build(field.getPoints());
 
     unsigned totalTriangles = 0;
 
-    // 2. Loop over each coordinate in the 3D grid.
-    #pragma omp parallel
+    if(mCacheField)
+        totalTriangles = marchCubesCached(field);
+    else
     {
-        #pragma omp for reduction(+: totalTriangles) nowait schedule(guided)
-        for(size_t i = 0; i < totalCubesCount; ++i)
+        // 2. Loop over each coordinate in the 3D grid.
+        #pragma omp parallel
         {
-            // 3. Compute 3D position in the grid.
-            Vec3_t<float> cubeOffset( i % mGridSize,
-                                    (i / mGridSize) % mGridSize,
-                                    i / (mGridSize*mGridSize));
-
-            // 4. Evaluate "Marching Cube" at given position in the grid and
-            //    store the number of triangles generated.
-            totalTriangles += buildCube(cubeOffset, field);
+            mTriangleBuffers.reset();
+
+            #pragma omp for reduction(+: totalTriangles) nowait schedule(guided)
+            for(size_t i = 0; i < totalCubesCount; ++i)
+            {
+                // 3. Compute 3D position in the grid.
+                Vec3_t<float> cubeOffset( i % mGridSize,
+                                        (i / mGridSize) % mGridSize,
+                                        i / (mGridSize*mGridSize));
+
+                // 4. Evaluate "Marching Cube" at given position in the grid and
+                //    store the number of triangles generated.
+                totalTriangles += buildCube(cubeOffset, field);
+            }
         }
     }
 
-    // 5. Return total number of triangles generated.
+    // 5. Concatenate the triangles of the threads into one array.
+    mTriangleBuffers.merge(mTriangles);
+
+    // 6. Return total number of triangles generated.
     return totalTriangles;
 }
 
-float LoopMeshBuilder::evaluateFieldAt(const Vec3_t<float> &pos, const ParametricScalarField &field)
+unsigned LoopMeshBuilder::marchCubesCached(const ParametricScalarField &field)
 {
-    // NOTE: This method is called from "buildCube(...)"!
+    // Only two planes of (mGridSize + 1)^2 vertices are kept, the top plane of a slab is the bottom of the next one
+    const size_t planeCubesCount = mGridSize*mGridSize;
+    const size_t planeVerticesCount = (mGridSize + 1)*(mGridSize + 1);
+    mFieldPlanes[0].resize(planeVerticesCount);
+    mFieldPlanes[1].resize(planeVerticesCount);
+
+    unsigned totalTriangles = 0;
+
+    #pragma omp parallel
+    {
+        mTriangleBuffers.reset();
+        evaluatePlane(mFieldPlanes[0], 0);
+
+        for(unsigned z = 0; z < mGridSize; ++z)
+        {
+            // 1. Evaluate the field at the top plane of the slab (implicit barrier of "omp for").
+            evaluatePlane(mFieldPlanes[1], z + 1);
+
+            #pragma omp single
+            mCachedSlab = z;
+
+            // 2. Build the cubes of the slab, their corners are read from the planes.
+            #pragma omp for reduction(+: totalTriangles) schedule(guided)
+            for(size_t i = 0; i < planeCubesCount; ++i)
+            {
+                Vec3_t<float> cubeOffset(i % mGridSize, i / mGridSize, z);
+                totalTriangles += buildCube(cubeOffset, field);
+            }
+
+            // 3. Top plane becomes the bottom one of the next slab.
+            #pragma omp single
+            std::swap(mFieldPlanes[0], mFieldPlanes[1]);
+        }
+    }
 
-    // 1. Store pointer to and number of 3D points in the field
-    //    (to avoid "data()" and "size()" call in the loop).
-    const Vec3_t<float> *pPoints = field.getPoints().data();
-    const unsigned count = unsigned(field.getPoints().size());
+    mCachedSlab = -1;
+    return totalTriangles;
+}
 
-    float value = std::numeric_limits<float>::max();
+void LoopMeshBuilder::evaluatePlane(std::vector<float> &plane, unsigned z)
+{
+    // NOTE: Called by all threads of the parallel region (work-shared loop)!
+    const unsigned edge = mGridSize + 1;
+    const unsigned batchSize = PointIndex::BATCH_SIZE;
+    const unsigned batchesPerRow = (edge + batchSize - 1) / batchSize;
+
+    // Neighbouring vertices of a row are evaluated by one batched query (they share most of the visited leaves).
+    // The position is computed the same way as the corners in "buildCube(...)", so the values are identical.
+    #pragma omp for schedule(guided)
+    for(size_t i = 0; i < size_t(edge)*batchesPerRow; ++i)
+    {
+        const unsigned y = unsigned(i / batchesPerRow);
+        const unsigned xStart = unsigned(i % batchesPerRow) * batchSize;
+        const unsigned count = std::min(batchSize, edge - xStart);
+
+        Vec3_t<float> pos[PointIndex::BATCH_SIZE];
+        float values[PointIndex::BATCH_SIZE];
+        for(unsigned k = 0; k < count; ++k)
+            pos[k] = Vec3_t<float>(float(xStart + k) * mGridResolution,
+                                   float(y) * mGridResolution,
+                                   float(z) * mGridResolution);
+
+        mPointIndex.nearestSquared(pos, count, values);
+        for(unsigned k = 0; k < count; ++k)
+            plane[y*edge + xStart + k] = sqrt(values[k]);
+    }
+}
 
-    // 2. Find minimum square distance from points "pos" to any point in the
-    //    field.
-    // #pragma omp parallel for reduction(min:value) schedule(static)
-    for(unsigned i = 0; i < count; ++i)
+float LoopMeshBuilder::evaluateFieldAt(const Vec3_t<float> &pos, const ParametricScalarField & /*field*/)
+{
+    // NOTE: This method is called from "buildCube(...)"!
+
+    // 0. Corners of the cubes of the current slab are already evaluated.
+    if(mCachedSlab >= 0)
     {
-        float distanceSquared  = (pos.x - pPoints[i].x) * (pos.x - pPoints[i].x);
-        distanceSquared       += (pos.y - pPoints[i].y) * (pos.y - pPoints[i].y);
-        distanceSquared       += (pos.z - pPoints[i].z) * (pos.z - pPoints[i].z);
+        const long x = lroundf(pos.x / mGridResolution);
+        const long y = lroundf(pos.y / mGridResolution);
+        const long plane = lroundf(pos.z / mGridResolution) - mCachedSlab;
+        const long edge = mGridSize + 1;
 
-        // Comparing squares instead of real distance to avoid unnecessary
-        // "sqrt"s in the loop.
-        value = std::min(value, distanceSquared);
+        if((plane == 0 || plane == 1) && x >= 0 && x < edge && y >= 0 && y < edge)
+            return mFieldPlanes[plane][y*edge + x];
     }
 
-    // 3. Finally take square root of the minimal square distance to get the real distance
+    // 1. Find minimum square distance from points "pos" to any point in the
+    //    field (k-d tree built by "marchCubes(...)" skips the distant points).
+    //    Comparing squares instead of real distance to avoid unnecessary "sqrt"s.
+    const float value = mPointIndex.nearestSquared(pos);
+
+    // 2. Finally take square root of the minimal square distance to get the real distance
     return sqrt(value);
 }
 
@@ -81,9 +160,9 @@ void LoopMeshBuilder::emitTriangle(const BaseMeshBuilder::Triangle_t &triangle)
 {
     // NOTE: This method is called from "buildCube(...)"!
 
-    // Store generated triangle into vector (array) of generated triangles.
-    // The pointer to data in this array is return by "getTrianglesArray(...)" call
-    // after "marchCubes(...)" call ends.
-    #pragma omp critical
-    mTriangles.push_back(triangle);
+    // Store generated triangle into the buffer of the calling thread (no locking).
+    // Buffers are merged into the vector (array) of generated triangles at the end
+    // of "marchCubes(...)", the pointer to data in this array is return by
+    // "getTrianglesArray(...)" call after "marchCubes(...)" call ends.
+    mTriangleBuffers.push(triangle);
 }
@@ -13,19 +13,34 @@
 
 #include <vector>
 #include "base_mesh_builder.h"
+#include "point_index.h"
+#include "triangle_buffers.h"
 
 class LoopMeshBuilder : public BaseMeshBuilder
 {
 public:
-    LoopMeshBuilder(unsigned gridEdgeSize);
+    /**
+     * @param gridEdgeSize number of cubes along the edge of the grid
+     * @param cacheField   evaluate the field once per grid vertex into two rolling planes of vertices (slab by
+     *                     slab) instead of at the 8 corners of every cube, the mesh is the same
+     */
+    LoopMeshBuilder(unsigned gridEdgeSize, bool cacheField = true);
 
 protected:
     unsigned marchCubes(const ParametricScalarField &field);
+    unsigned marchCubesCached(const ParametricScalarField &field);
+    void evaluatePlane(std::vector<float> &plane, unsigned z);
     float evaluateFieldAt(const Vec3_t<float> &pos, const ParametricScalarField &field);
     void emitTriangle(const Triangle_t &triangle);
     const Triangle_t *getTrianglesArray() const { return mTriangles.data(); }
 
     std::vector<Triangle_t> mTriangles; ///< Temporary array of triangles
+    PointIndex mPointIndex;             ///< Nearest-point index of the field points
+    TriangleBuffers mTriangleBuffers;   ///< Triangles emitted by the threads, merged into mTriangles
+
+    const bool mCacheField;             ///< Cubes read the field from the planes of vertices
+    std::vector<float> mFieldPlanes[2]; ///< Field at the vertices of the bottom and top plane of the current slab
+    long mCachedSlab = -1;              ///< Slab of cubes covered by the planes (-1 = none)
 };
 
 #endif // LOOP_MESH_BUILDER_H
@@ -0,0 +1,348 @@
+/**
+ * @file    point_index.cpp
+ *
+ * @author  Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ *
+ * @brief   k-d tree over the points of the scalar field for nearest-point queries
+ *
+ * @date    17.10.2026
+ **/
+
+#include <algorithm>
+#include <limits>
+#include <math.h>
+
+#include <immintrin.h> // _mm_malloc()
+
+#include "point_index.h"
+
+// Box distances are lowered by a few ulps. The compiler may contract the squared distances of the points into FMAs
+// (GCC does at -O3 -march=native), which rounds them below the uncontracted box distance by up to ~3 ulps.
+static const float BOX_DISTANCE_SCALE = 1.0f - 8.0f * std::numeric_limits<float>::epsilon();
+
+static inline float coordinate(const Vec3_t<float> &p, unsigned axis)
+{
+    return axis == 0 ? p.x : (axis == 1 ? p.y : p.z);
+}
+
+PointIndex::~PointIndex()
+{
+    _mm_free(mX);
+    _mm_free(mY);
+    _mm_free(mZ);
+}
+
+void PointIndex::build(const std::vector<Vec3_t<float>> &points)
+{
+    mNodes.clear();
+    _mm_free(mX);
+    _mm_free(mY);
+    _mm_free(mZ);
+    mX = mY = mZ = nullptr;
+    if(points.empty())
+        return;
+
+    // Leaves hold at least LEAF_SIZE / 2 points, so the balanced tree has less nodes than this
+    std::vector<Vec3_t<float>> ordered(points);
+    mNodes.reserve(4 * ordered.size() / LEAF_SIZE + 1);
+    buildNode(ordered, 0, unsigned(ordered.size()));
+    storeLeaves(ordered);
+}
+
+unsigned PointIndex::buildNode(std::vector<Vec3_t<float>> &points, unsigned begin, unsigned end)
+{
+    const unsigned index = unsigned(mNodes.size());
+    mNodes.push_back(Node());
+    Node &node = mNodes.back();
+
+    // 1. Bounding box of the points of the node.
+    for(unsigned axis = 0; axis < 3; ++axis)
+    {
+        node.lo[axis] = std::numeric_limits<float>::max();
+        node.hi[axis] = std::numeric_limits<float>::lowest();
+    }
+    for(unsigned i = begin; i < end; ++i)
+    {
+        for(unsigned axis = 0; axis < 3; ++axis)
+        {
+            node.lo[axis] = std::min(node.lo[axis], coordinate(points[i], axis));
+            node.hi[axis] = std::max(node.hi[axis], coordinate(points[i], axis));
+        }
+    }
+    node.begin = begin;
+    node.end = end;
+    node.left = node.right = 0;
+
+    if(end - begin <= LEAF_SIZE)
+        return index;
+
+    // 2. Split by the median of the longest side of the box.
+    unsigned axis = 0;
+    for(unsigned a = 1; a < 3; ++a)
+        if(node.hi[a] - node.lo[a] > node.hi[axis] - node.lo[axis])
+            axis = a;
+
+    const unsigned middle = begin + (end - begin) / 2;
+    std::nth_element(points.begin() + begin, points.begin() + middle, points.begin() + end,
+                     [axis](const Vec3_t<float> &a, const Vec3_t<float> &b) {
+                         return coordinate(a, axis) < coordinate(b, axis);
+                     });
+
+    const unsigned left = buildNode(points, begin, middle);
+    const unsigned right = buildNode(points, middle, end);
+    mNodes[index].left = left;
+    mNodes[index].right = right;
+    return index;
+}
+
+void PointIndex::storeLeaves(const std::vector<Vec3_t<float>> &points)
+{
+    // 1. Every leaf starts at a multiple of SIMD_WIDTH (aligned vectors).
+    size_t total = 0;
+    for(const Node &node : mNodes)
+        if(node.left == 0)
+            total += (node.end - node.begin + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+
+    mX = (float*)_mm_malloc(total * sizeof(float), 64);
+    mY = (float*)_mm_malloc(total * sizeof(float), 64);
+    mZ = (float*)_mm_malloc(total * sizeof(float), 64);
+
+    // 2. Padding points are so far that their squared distance is infinite (never the minimum).
+    unsigned offset = 0;
+    for(Node &node : mNodes)
+    {
+        if(node.left != 0)
+            continue;
+
+        const unsigned count = node.end - node.begin;
+        const unsigned padded = (count + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+        for(unsigned i = 0; i < padded; ++i)
+        {
+            const bool point = i < count;
+            mX[offset + i] = point ? points[node.begin + i].x : std::numeric_limits<float>::max();
+            mY[offset + i] = point ? points[node.begin + i].y : std::numeric_limits<float>::max();
+            mZ[offset + i] = point ? points[node.begin + i].z : std::numeric_limits<float>::max();
+        }
+        node.begin = offset;
+        node.end = offset + padded;
+        offset += padded;
+    }
+}
+
+float PointIndex::boxDistanceSquared(const Node &node, const Vec3_t<float> &pos)
+{
+    // Rounding is monotonic, so the scaled result is never above the (possibly contracted) distance of any point in
+    // the box
+    const float dx = std::max(std::max(node.lo[0] - pos.x, pos.x - node.hi[0]), 0.0f);
+    const float dy = std::max(std::max(node.lo[1] - pos.y, pos.y - node.hi[1]), 0.0f);
+    const float dz = std::max(std::max(node.lo[2] - pos.z, pos.z - node.hi[2]), 0.0f);
+
+    float distanceSquared  = dx * dx;
+    distanceSquared       += dy * dy;
+    distanceSquared       += dz * dz;
+    return distanceSquared * BOX_DISTANCE_SCALE;
+}
+
+float PointIndex::nearestSquared(const Vec3_t<float> &pos) const
+{
+    float value = std::numeric_limits<float>::max();
+    if(mNodes.empty())
+        return value;
+
+    // Explicit stack of (node, distance of its box), depth of the balanced tree is below 32
+    struct Entry { unsigned node; float distance; };
+    Entry stack[64];
+    unsigned top = 0;
+    stack[top++] = {0, boxDistanceSquared(mNodes[0], pos)};
+
+    while(top > 0)
+    {
+        const Entry entry = stack[--top];
+        if(entry.distance > value)
+            continue;
+
+        const Node &node = mNodes[entry.node];
+        if(node.left == 0)
+        {
+            const float *pX = mX + node.begin;
+            const float *pY = mY + node.begin;
+            const float *pZ = mZ + node.begin;
+            const unsigned count = node.end - node.begin;
+
+            #pragma omp simd reduction(min: value) aligned(pX, pY, pZ: 64)
+            for(unsigned i = 0; i < count; ++i)
+            {
+                float distanceSquared  = (pos.x - pX[i]) * (pos.x - pX[i]);
+                distanceSquared       += (pos.y - pY[i]) * (pos.y - pY[i]);
+                distanceSquared       += (pos.z - pZ[i]) * (pos.z - pZ[i]);
+
+                value = std::min(value, distanceSquared);
+            }
+            continue;
+        }
+
+        // The nearer child is pushed last, so it is searched first and tightens the bound for the other one
+        const Entry left = {node.left, boxDistanceSquared(mNodes[node.left], pos)};
+        const Entry right = {node.right, boxDistanceSquared(mNodes[node.right], pos)};
+        if(left.distance < right.distance)
+        {
+            stack[top++] = right;
+            stack[top++] = left;
+        }
+        else
+        {
+            stack[top++] = left;
+            stack[top++] = right;
+        }
+    }
+
+    return value;
+}
+
+bool PointIndex::hasPointWithin(const Vec3_t<float> &pos, float distance) const
+{
+    if(mNodes.empty() || distance < 0.0f)
+        return sqrtf(std::numeric_limits<float>::max()) <= distance;
+
+    // 1. The largest squared distance whose rounded square root is within the distance, so the result is the same
+    //    as comparing the real (rounded) distance of the nearest point.
+    float limit = distance * distance;
+    while(sqrtf(limit) > distance)
+        limit = nextafterf(limit, 0.0f);
+    while(limit < std::numeric_limits<float>::max() && sqrtf(nextafterf(limit, INFINITY)) <= distance)
+        limit = nextafterf(limit, INFINITY);
+
+    unsigned stack[64];
+    unsigned top = 0;
+    stack[top++] = 0;
+
+    while(top > 0)
+    {
+        const Node &node = mNodes[stack[--top]];
+        if(boxDistanceSquared(node, pos) > limit)
+            continue;
+
+        // 2. Leaf is scanned as a whole (one vector pass), the search ends with the first leaf within the limit.
+        if(node.left == 0)
+        {
+            const float *pX = mX + node.begin;
+            const float *pY = mY + node.begin;
+            const float *pZ = mZ + node.begin;
+            const unsigned count = node.end - node.begin;
+            int found = 0;
+
+            #pragma omp simd reduction(|: found) aligned(pX, pY, pZ: 64)
+            for(unsigned i = 0; i < count; ++i)
+            {
+                float distanceSquared  = (pos.x - pX[i]) * (pos.x - pX[i]);
+                distanceSquared       += (pos.y - pY[i]) * (pos.y - pY[i]);
+                distanceSquared       += (pos.z - pZ[i]) * (pos.z - pZ[i]);
+
+                found |= distanceSquared <= limit;
+            }
+            if(found)
+                return true;
+            continue;
+        }
+
+        // 3. The nearer child is more likely to contain a close point.
+        const bool leftFirst = boxDistanceSquared(mNodes[node.left], pos) < boxDistanceSquared(mNodes[node.right], pos);
+        stack[top++] = leftFirst ? node.right : node.left;
+        stack[top++] = leftFirst ? node.left : node.right;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Squared distances of the box of the node from the positions of the batch (vectorized over the positions)
+ */
+static inline void batchBoxDistances(const float *lo, const float *hi, const float *qX, const float *qY,
+                                     const float *qZ, float *distances)
+{
+    #pragma omp simd aligned(qX, qY, qZ, distances: 64)
+    for(unsigned q = 0; q < PointIndex::BATCH_SIZE; ++q)
+    {
+        const float dx = std::max(std::max(lo[0] - qX[q], qX[q] - hi[0]), 0.0f);
+        const float dy = std::max(std::max(lo[1] - qY[q], qY[q] - hi[1]), 0.0f);
+        const float dz = std::max(std::max(lo[2] - qZ[q], qZ[q] - hi[2]), 0.0f);
+
+        float distanceSquared  = dx * dx;
+        distanceSquared       += dy * dy;
+        distanceSquared       += dz * dz;
+        distances[q] = distanceSquared * BOX_DISTANCE_SCALE;
+    }
+}
+
+void PointIndex::nearestSquared(const Vec3_t<float> *pos, unsigned count, float *values) const
+{
+    if(count == 0)
+        return;
+
+    // 1. Positions as SoA, unused lanes repeat the last position.
+    alignas(64) float qX[BATCH_SIZE], qY[BATCH_SIZE], qZ[BATCH_SIZE];
+    alignas(64) float best[BATCH_SIZE];
+    alignas(64) float distances[BATCH_SIZE];
+    for(unsigned q = 0; q < BATCH_SIZE; ++q)
+    {
+        const Vec3_t<float> &p = pos[std::min(q, count - 1)];
+        qX[q] = p.x;
+        qY[q] = p.y;
+        qZ[q] = p.z;
+        best[q] = std::numeric_limits<float>::max();
+    }
+
+    unsigned stack[64];
+    unsigned top = 0;
+    if(!mNodes.empty())
+        stack[top++] = 0;
+
+    while(top > 0)
+    {
+        const Node &node = mNodes[stack[--top]];
+
+        // 2. Node is skipped if its box is farther than the best point of every position.
+        batchBoxDistances(node.lo, node.hi, qX, qY, qZ, distances);
+        bool visit = false;
+        for(unsigned q = 0; q < BATCH_SIZE; ++q)
+            visit |= distances[q] <= best[q];
+        if(!visit)
+            continue;
+
+        // 3. Points of the leaf are broadcast and compared with all positions at once.
+        if(node.left == 0)
+        {
+            for(unsigned i = node.begin; i < node.end; ++i)
+            {
+                const float x = mX[i];
+                const float y = mY[i];
+                const float z = mZ[i];
+
+                #pragma omp simd aligned(qX, qY, qZ, best: 64)
+                for(unsigned q = 0; q < BATCH_SIZE; ++q)
+                {
+                    float distanceSquared  = (qX[q] - x) * (qX[q] - x);
+                    distanceSquared       += (qY[q] - y) * (qY[q] - y);
+                    distanceSquared       += (qZ[q] - z) * (qZ[q] - z);
+
+                    best[q] = std::min(best[q], distanceSquared);
+                }
+            }
+            continue;
+        }
+
+        // 4. Child nearer to the whole batch is searched first.
+        float leftSum = 0.0f, rightSum = 0.0f;
+        batchBoxDistances(mNodes[node.left].lo, mNodes[node.left].hi, qX, qY, qZ, distances);
+        for(unsigned q = 0; q < BATCH_SIZE; ++q)
+            leftSum += distances[q];
+        batchBoxDistances(mNodes[node.right].lo, mNodes[node.right].hi, qX, qY, qZ, distances);
+        for(unsigned q = 0; q < BATCH_SIZE; ++q)
+            rightSum += distances[q];
+
+        stack[top++] = leftSum < rightSum ? node.right : node.left;
+        stack[top++] = leftSum < rightSum ? node.left : node.right;
+    }
+
+    std::copy(best, best + count, values);
+}
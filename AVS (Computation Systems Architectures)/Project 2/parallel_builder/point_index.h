@@ -0,0 +1,88 @@
+/**
+ * @file    point_index.h
+ *
+ * @author  Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ *
+ * @brief   k-d tree over the points of the scalar field for nearest-point queries
+ *
+ * @date    17.10.2026
+ **/
+
+#ifndef POINT_INDEX_H
+#define POINT_INDEX_H
+
+#include <vector>
+#include "base_mesh_builder.h"
+
+/**
+ * @brief Balanced k-d tree with small buckets of points in the leaves
+ *
+ * Nodes keep the bounding box of their points, so a query visits the nearer child first and skips every subtree
+ * whose box is farther than the closest point found so far. The minimum is exact (same squared distances as the
+ * linear scan of all points), the box distances are lowered by a few ulps, so a point distance contracted into FMAs
+ * by the compiler is never pruned (check/point_index_check.cpp compares the queries with the scan).
+ *
+ * Points of the leaves are stored as SoA (separate x, y and z arrays, 64 B aligned) and every leaf is padded to
+ * a multiple of SIMD_WIDTH by far-away points, so the distance kernels run on full aligned vectors (AVX2 / AVX-512).
+ */
+class PointIndex
+{
+public:
+    static const unsigned BATCH_SIZE = 16; ///< Maximum number of positions of the batched query
+
+    PointIndex() {}
+    PointIndex(const PointIndex &) = delete;
+    PointIndex &operator=(const PointIndex &) = delete;
+    ~PointIndex();
+
+    /**
+     * @brief Builds the tree over the points (called once per field, before the parallel part)
+     */
+    void build(const std::vector<Vec3_t<float>> &points);
+
+    /**
+     * @brief Minimum squared distance from "pos" to the points (float max for no points), thread safe
+     */
+    float nearestSquared(const Vec3_t<float> &pos) const;
+
+    /**
+     * @brief Minimum squared distances of up to BATCH_SIZE nearby positions (e.g. neighbouring grid vertices)
+     *
+     * The tree is traversed once for the whole batch, every visited leaf is loaded once and compared with all
+     * positions. The values are the same as of the single queries.
+     */
+    void nearestSquared(const Vec3_t<float> *pos, unsigned count, float *values) const;
+
+    /**
+     * @brief True if sqrt(nearestSquared(pos)) <= distance, thread safe
+     *
+     * Stops at the first leaf with a point close enough and never enters the subtrees whose box is farther, so
+     * the positions far from all points are rejected after a few nodes.
+     */
+    bool hasPointWithin(const Vec3_t<float> &pos, float distance) const;
+
+protected:
+    static const unsigned LEAF_SIZE = 32;  ///< Maximum number of points in a leaf (before padding)
+    static const unsigned SIMD_WIDTH = 16; ///< Leaves are padded to full AVX-512 vectors of floats
+
+    struct Node
+    {
+        float lo[3];    ///< Bounding box of the points of the node
+        float hi[3];
+        unsigned begin; ///< Points [begin, end) in the SoA arrays (leaves only, padded)
+        unsigned end;
+        unsigned left;  ///< Children (0 = leaf, the root is never a child)
+        unsigned right;
+    };
+
+    unsigned buildNode(std::vector<Vec3_t<float>> &points, unsigned begin, unsigned end);
+    void storeLeaves(const std::vector<Vec3_t<float>> &points);
+    static float boxDistanceSquared(const Node &node, const Vec3_t<float> &pos);
+
+    std::vector<Node> mNodes; ///< Nodes, the root first
+    float *mX = nullptr;      ///< Coordinates of the points of the leaves (leaf by leaf)
+    float *mY = nullptr;
+    float *mZ = nullptr;
+};
+
+#endif // POINT_INDEX_H
@@ -31,10 +31,10 @@ unsigned int TreeMeshBuilder::decomposeOctree(const unsigned gridSize, const Vec
         (pos.y + newGridSize) * mGridResolution,
         (pos.z + newGridSize) * mGridResolution 
     };
-    float fieldPoint = evaluateFieldAt(midPoint, field);
     float fieldCondition = mIsoLevel + sphere_radius_exp * (gridSize * mGridResolution);
 
-    if (fieldPoint <= fieldCondition){
+    /* Presná hodnota poľa netreba, stačí vedieť či je niektorý bod bližšie ako fieldCondition */
+    if (isFieldBelow(midPoint, fieldCondition)){
         /* 2.1. Ak je dosiahnuté maximálne zanorenie - podmenka konca rekurzie */
         if (gridSize <= GRID_SIZE_CUTOFF){
             unsigned cubeTriangles = 0;
@@ -78,37 +78,32 @@ unsigned int TreeMeshBuilder::decomposeOctree(const unsigned gridSize, const Vec
 unsigned TreeMeshBuilder::marchCubes(const ParametricScalarField &field)
 {
     unsigned totalTriangles = 0; // Triangle counter
+    mPointIndex.build(field.getPoints());
     #pragma omp parallel shared(field, totalTriangles)
     {
+        mTriangleBuffers.reset();
         #pragma omp master
         {
             totalTriangles = decomposeOctree(mGridSize, Vec3_t<float>(), field);
         }
     }
+    mTriangleBuffers.merge(mTriangles);
     return totalTriangles;
 }
 
-float TreeMeshBuilder::evaluateFieldAt(const Vec3_t<float> &pos, const ParametricScalarField &field)
+float TreeMeshBuilder::evaluateFieldAt(const Vec3_t<float> &pos, const ParametricScalarField & /*field*/)
 {
-    const Vec3_t<float> *pPoints = field.getPoints().data();
-    const unsigned count = unsigned(field.getPoints().size());
-
-    float value = std::numeric_limits<float>::max();
-
-    for(unsigned i = 0; i < count; ++i)
-    {
-        float distanceSquared  = (pos.x - pPoints[i].x) * (pos.x - pPoints[i].x);
-        distanceSquared       += (pos.y - pPoints[i].y) * (pos.y - pPoints[i].y);
-        distanceSquared       += (pos.z - pPoints[i].z) * (pos.z - pPoints[i].z);
-
-        value = std::min(value, distanceSquared);
-    }
+    return sqrt(mPointIndex.nearestSquared(pos));
+}
 
-    return sqrt(value);
+bool TreeMeshBuilder::isFieldBelow(const Vec3_t<float> &pos, float threshold) const
+{
+    /* Rovnaký výsledok ako evaluateFieldAt(pos, field) <= threshold, ale hľadanie končí prvým blízkym bodom */
+    return mPointIndex.hasPointWithin(pos, threshold);
 }
 
 void TreeMeshBuilder::emitTriangle(const BaseMeshBuilder::Triangle_t &triangle)
 {
-    #pragma omp critical
-    mTriangles.push_back(triangle);
+    /* Tasky sú viazané na vlákno, takže buffer vlákna používa vždy len jedno vlákno */
+    mTriangleBuffers.push(triangle);
 }
@@ -12,6 +12,8 @@
 #define TREE_MESH_BUILDER_H
 
 #include "base_mesh_builder.h"
+#include "point_index.h"
+#include "triangle_buffers.h"
 
 class TreeMeshBuilder : public BaseMeshBuilder
 {
@@ -22,6 +24,7 @@ protected:
     unsigned int decomposeOctree(const unsigned gridSize, const Vec3_t<float> &pos, const ParametricScalarField &field);
     unsigned marchCubes(const ParametricScalarField &field);
     float evaluateFieldAt(const Vec3_t<float> &pos, const ParametricScalarField &field);
+    bool isFieldBelow(const Vec3_t<float> &pos, float threshold) const;
     void emitTriangle(const Triangle_t &triangle);
     const Triangle_t *getTrianglesArray() const { return mTriangles.data(); }
 
@@ -29,6 +32,8 @@ protected:
     const unsigned int GRID_SIZE_CUTOFF = 2;
     const unsigned int TREE_CHILDS = 8;
     std::vector<Triangle_t> mTriangles; ///< Temporary array of triangles
+    PointIndex mPointIndex;             ///< Nearest-point index of the field points
+    TriangleBuffers mTriangleBuffers;   ///< Triangles emitted by the threads, merged into mTriangles
 };
 
 #endif // TREE_MESH_BUILDER_H
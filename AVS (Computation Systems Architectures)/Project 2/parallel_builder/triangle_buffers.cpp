@@ -0,0 +1,39 @@
+/**
+ * @file    triangle_buffers.cpp
+ *
+ * @author  Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ *
+ * @brief   Per-thread buffers of emitted triangles merged into one array after the parallel part
+ *
+ * @date    17.10.2026
+ **/
+
+#include <algorithm>
+
+#include "triangle_buffers.h"
+
+void TriangleBuffers::reset()
+{
+    // 1. One buffer per thread of the current team (implicit barrier, no thread pushes before the resize).
+    #pragma omp single
+    mBuffers.resize(omp_get_num_threads());
+
+    // 2. Every thread empties its own buffer, the capacity is kept for the next mesh.
+    mBuffers[omp_get_thread_num()].triangles.clear();
+}
+
+void TriangleBuffers::merge(std::vector<Triangle_t> &triangles)
+{
+    // 1. Exclusive prefix sum of the buffer sizes gives the offset of each buffer in the output
+    //    (one element per thread, so it is not worth parallelizing).
+    std::vector<size_t> offsets(mBuffers.size() + 1, 0);
+    for(size_t t = 0; t < mBuffers.size(); ++t)
+        offsets[t + 1] = offsets[t] + mBuffers[t].triangles.size();
+
+    triangles.resize(offsets.back());
+
+    // 2. Every thread copies one buffer into its own part of the output.
+    #pragma omp parallel for schedule(static)
+    for(size_t t = 0; t < mBuffers.size(); ++t)
+        std::copy(mBuffers[t].triangles.begin(), mBuffers[t].triangles.end(), triangles.begin() + offsets[t]);
+}
@@ -0,0 +1,59 @@
+/**
+ * @file    triangle_buffers.h
+ *
+ * @author  Michal Ľaš <xlasmi00@stud.fit.vutbr.cz>
+ *
+ * @brief   Per-thread buffers of emitted triangles merged into one array after the parallel part
+ *
+ * @date    17.10.2026
+ **/
+
+#ifndef TRIANGLE_BUFFERS_H
+#define TRIANGLE_BUFFERS_H
+
+#include <vector>
+#include <cassert>
+#include <omp.h>
+#include "base_mesh_builder.h"
+
+/**
+ * @brief Every thread appends to its own buffer without locking, "merge(...)" concatenates them
+ */
+class TriangleBuffers
+{
+public:
+    typedef BaseMeshBuilder::Triangle_t Triangle_t;
+
+    /**
+     * @brief Empties the buffers, one for each thread of the team
+     *
+     * Called by all threads at the start of the parallel region that pushes the triangles (the team may be smaller
+     * than omp_get_max_threads(), e.g. with dynamic adjustment or a num_threads clause).
+     */
+    void reset();
+
+    /**
+     * @brief Appends the triangle to the buffer of the calling thread (of the team that called "reset()")
+     */
+    void push(const Triangle_t &triangle)
+    {
+        assert(size_t(omp_get_thread_num()) < mBuffers.size());
+        mBuffers[omp_get_thread_num()].triangles.push_back(triangle);
+    }
+
+    /**
+     * @brief Replaces the content of "triangles" by the triangles of all buffers (buffer by buffer)
+     */
+    void merge(std::vector<Triangle_t> &triangles);
+
+protected:
+    /// Buffers of neighbouring threads do not share a cache line
+    struct alignas(64) Buffer
+    {
+        std::vector<Triangle_t> triangles;
+    };
+
+    std::vector<Buffer> mBuffers;
+};
+
+#endif // TRIANGLE_BUFFERS_H